@@ -0,0 +1,503 @@
+#include "CadicalAssignmentPropagator.h"
+
+#include "IncSatGC.h" //make type information available to use here for pointer of IncSatGC object
+
+# define  DEBUG_PRINT(X) //do {X} while(0)  //debug print that can be disabled easily
+
+CadicalAssignmentPropagator::~CadicalAssignmentPropagator() = default;
+
+void CadicalAssignmentPropagator::notify_assignment(const std::vector<int>& lits) {
+    stats.prop_num_assignments += static_cast<int>(lits.size());
+    for(int lit : lits) {
+        if(val(lit) != 0){
+            //might get notified about the same assignment twice
+            assert(val(lit) == 1);
+            continue;
+        }
+        vals[std::abs(lit)] = static_cast<signed char>(sign(lit));
+        current_trail.back().push_back(lit);
+        num_assigned++;
+        num_assignments++;
+        if(std::abs(lit) > highest_x_var) {
+            //guard literal of the bottom-up search, nothing to propagate
+            continue;
+        }
+        int v = (std::abs(lit) - 1) / encoding_colors;
+        int c = (std::abs(lit) - 1) % encoding_colors;
+        check_symmetry = true;
+        DEBUG_PRINT(std::cout << "Was notified of assignment of literal " << lit << " = x_" << v << "," << c
+                              << " at level " << current_level << "\n";);
+        if(lit > 0) {
+            assign_color(v, c);
+        }
+        else {
+            forbid_color(v, c);
+        }
+    }
+}
+
+void CadicalAssignmentPropagator::notify_new_decision_level() {
+    assert(static_cast<std::size_t>(current_level) + 1 == current_trail.size());
+    current_level++;
+    DEBUG_PRINT(std::cout << "Was notified of new decision level " << current_level << "\n";);
+    propagations.clear();
+    clauses.clear();
+    assert(external_clauses.empty());
+    current_trail.emplace_back();
+    if(use_bounds) {
+        mgraph.notify_new_level();
+    }
+    stats.prop_max_level = std::max(stats.prop_max_level, current_level);
+}
+
+void CadicalAssignmentPropagator::notify_backtrack(size_t new_level) {
+    DEBUG_PRINT(std::cout << "Was notified of backtrack: " << new_level << "\n";);
+    stats.prop_num_backtracks++;
+    assert(static_cast<std::size_t>(current_level) > new_level);
+    while (static_cast<std::size_t>(current_level) > new_level){
+        for(auto l_it = current_trail.back().rbegin(); l_it != current_trail.back().rend(); ++l_it){
+            unassign(*l_it);
+        }
+        current_trail.pop_back();
+        current_level--;
+        assert(static_cast<std::size_t>(current_level) + 1 == current_trail.size());
+    }
+    if(use_bounds) {
+        mgraph.notify_backtrack_level(static_cast<int>(new_level));
+    }
+    //reset all propagation info and bound explanations
+    propagations.clear();
+    clauses.clear();
+    external_clauses.clear();
+    maximal_cliques.clear();
+    max_clique_size = -1;
+    first_call_after_backtrack = true;
+    check_symmetry = true;
+}
+
+bool CadicalAssignmentPropagator::cb_check_found_model(const std::vector<int> &model) {
+    //all x_v,c are observed in order, so model[x_v,c - 1] is the value of x_v,c
+    //the constraints are propagated eagerly so there should be no violations, but add them as clauses if there are
+    assert(external_clauses.empty());
+    std::vector<int> model_color(num_vertices, NoColor);
+    for (int v = 0; v < num_vertices; ++v) {
+        for (int c = 0; c < encoding_colors; ++c) {
+            if(model[literal(v, c) - 1] <= 0) {
+                continue;
+            }
+            if(model_color[v] != NoColor) {
+                external_clauses.push_back({-literal(v, model_color[v]), -literal(v, c)});
+            }
+            else {
+                model_color[v] = c;
+            }
+        }
+    }
+    for (int v = 0; v < num_vertices; ++v) {
+        for (int u : neighbors[v]) {
+            if(u > v and model_color[u] != NoColor and model_color[u] == model_color[v]) {
+                external_clauses.push_back({-literal(v, model_color[v]), -literal(u, model_color[u])});
+            }
+        }
+    }
+    DEBUG_PRINT(std::cout << "EP checked found model, " << external_clauses.size() << " violated constraints\n";);
+    return external_clauses.empty();
+}
+
+int CadicalAssignmentPropagator::cb_decide() {
+    stats.prop_num_decisions++;
+    return dsatur_literal();
+}
+
+int CadicalAssignmentPropagator::cb_propagate() {
+    assert(clauses.size() == propagations.size());
+    if(propagations.empty() and check_symmetry) {
+        find_symmetry_propagations();
+    }
+    while (not propagations.empty()){
+        //get next propagation and store corresponding reason clause in literal_to_clause
+        int literal = propagations.front();
+        propagations.pop_front();
+        std::vector<int> reason_clause = std::move(clauses.front());
+        clauses.pop_front();
+        if(val(literal) == 1) {
+            continue; //literal is already true, take next propagation
+        }
+        //a false literal is propagated as well, cadical then asks for its reason clause and finds the conflict
+        assert(std::find(reason_clause.begin(), reason_clause.end(), literal) != reason_clause.end());
+        if(literal > 0) {
+            literal_to_clause_pos[std::abs(literal)] = std::move(reason_clause);
+        }
+        else {
+            literal_to_clause_neg[std::abs(literal)] = std::move(reason_clause);
+        }
+        DEBUG_PRINT(std::cout << "cb_propagate " << literal << "\n";);
+        stats.prop_num_propagations++;
+        return literal;
+    }
+    return 0;
+}
+
+int CadicalAssignmentPropagator::cb_add_reason_clause_lit(int propagated_lit) {
+    assert(propagated_lit != 0);
+    int abslit = std::abs(propagated_lit);
+    auto &reason = (propagated_lit > 0 ? literal_to_clause_pos[abslit] : literal_to_clause_neg[abslit]);
+    if (not reason.empty()){
+        auto lit = reason.back();
+        reason.pop_back();
+        return lit;
+    }
+    //gave reason clause, increment stat
+    stats.prop_num_reason_clauses++;
+    return 0;
+}
+
+bool CadicalAssignmentPropagator::cb_has_external_clause(bool& is_forgettable) {
+    if(not external_clauses.empty()) {
+        //violated constraints of a checked model have to be added
+        is_forgettable = false;
+        return true;
+    }
+    //only look for bounds if there are no more propagations to be made, so the contracted graph is complete
+    if(not use_bounds or not propagations.empty() or not guard_is_set()) {
+        return false;
+    }
+    check_for_clique_clauses();
+    if(options.use_mycielsky_explanation_clauses and first_call_after_backtrack and external_clauses.empty()) {
+        check_for_mycielsky_clauses();
+    }
+    first_call_after_backtrack = false;
+    if(not external_clauses.empty()){
+        is_forgettable = true; //the explanation clauses can be forgotten, we only really want to use them to backtrack once
+        return true;
+    }
+    return false;
+}
+
+int CadicalAssignmentPropagator::cb_add_external_clause_lit() {
+    std::vector<int> &clause = external_clauses.back();
+    if (not clause.empty()){
+        int lit = clause.back();
+        clause.pop_back();
+        return lit;
+    }
+    // delete last clause
+    external_clauses.pop_back();
+    stats.prop_num_external_clauses++;
+    return 0;
+}
+
+
+/*
+ * New section for new data members and functions
+ */
+
+CadicalAssignmentPropagator::CadicalAssignmentPropagator(IncSatGC &reference, const int num_colors_)
+    : stats(reference.stats), options(reference.options)
+{
+    INSTANCE = &reference;
+    num_vertices = INSTANCE->num_vertices;
+    encoding_colors = num_colors_;
+    num_colors = num_colors_;
+    highest_x_var = encoding_colors * num_vertices;
+    neighbors = INSTANCE->graph.get_neighbor_list();
+    symmetry_order = INSTANCE->color_ordering_vertex_order();
+
+    vertex_color = std::vector<int>(num_vertices, NoColor);
+    class_size = std::vector<int>(encoding_colors, 0);
+    class_anchor = std::vector<int>(encoding_colors, -1);
+    num_forbidden = std::vector<int>(num_vertices, 0);
+    use_bounds = options.use_clique_explanation_clauses;
+    if(use_bounds) {
+        mgraph = MGraph(num_vertices, INSTANCE->graph.ecount(), INSTANCE->graph.elist());
+        if(options.use_mycielsky_explanation_clauses) {
+            mycielsky_cache = MGraph::MycielskyCache(num_vertices);
+        }
+        if(options.mnts_length > 0) {
+            mnts_engine = std::make_unique<MNTS>(num_vertices, options.mnts_length, options.mnts_depth);
+            mnts_previous_clique = Bitset(num_vertices);
+        }
+    }
+
+    literal_to_clause_pos = std::vector<std::vector<int>>(highest_x_var + 1);
+    literal_to_clause_neg = std::vector<std::vector<int>>(highest_x_var + 1);
+    current_trail.emplace_back();
+    vals = std::vector<signed char>(highest_x_var + 1, 0);
+}
+
+void CadicalAssignmentPropagator::update_num_colors(const int num_colors_, const int guard_literal_) {
+    assert(num_colors_ <= encoding_colors);
+    num_colors = num_colors_;
+    guard_literal = guard_literal_;
+    if(guard_literal != 0) {
+        assert(guard_literal > highest_x_var);
+        //observe the guard so that it can be part of the bound clauses
+        auto solver = std::dynamic_pointer_cast<CaDiCaLAdaptor::Solver>(INSTANCE->solver);
+        solver->solver.add_observed_var(guard_literal);
+        if(guard_literal >= static_cast<int>(vals.size())) {
+            vals.resize(guard_literal + 1, 0);
+        }
+    }
+}
+
+bool CadicalAssignmentPropagator::guard_is_set() const {
+    //bounds only hold once the guard restricting the number of colors is assumed
+    return guard_literal == 0 or val(guard_literal) == 1;
+}
+
+signed char CadicalAssignmentPropagator::val(const int lit) const {
+    assert(lit != 0 and std::abs(lit) < static_cast<int>(vals.size()));
+    return static_cast<signed char>(sign(lit) * vals[std::abs(lit)]);
+}
+
+void CadicalAssignmentPropagator::propagate_binary(const int reason_lit, const int propagated_lit) {
+    propagations.push_back(propagated_lit);
+    clauses.push_back({reason_lit, propagated_lit});
+}
+
+void CadicalAssignmentPropagator::assign_color(const int v, const int c) {
+    //x_v,c is true: neighbours of v can't have color c, and v has no other color
+    bool is_conflicting = false;
+    for (int u : neighbors[v]) {
+        if(val(literal(u, c)) != -1) {
+            is_conflicting |= val(literal(u, c)) == 1;
+            propagate_binary(-literal(v, c), -literal(u, c));
+        }
+    }
+    for (int d = 0; d < encoding_colors; ++d) {
+        if(d != c and val(literal(v, d)) != -1) {
+            is_conflicting |= val(literal(v, d)) == 1;
+            propagate_binary(-literal(v, c), -literal(v, d));
+        }
+    }
+    if(is_conflicting) {
+        //the propagations lead to a conflict, keep the coloring and graph as they are until the backtrack
+        return;
+    }
+    assert(vertex_color[v] == NoColor);
+    vertex_color[v] = c;
+    if(class_size[c]++ == 0) {
+        class_anchor[c] = v;
+    }
+    if(not use_bounds) {
+        return;
+    }
+    if(class_size[c] > 1) {
+        //put v into its color class
+        assert(not mgraph.has_edge(v, class_rep(c)));
+        mgraph.contract_vertices(v, class_rep(c));
+        return;
+    }
+    //v starts a new color class, which is adjacent to the other classes
+    //and to the uncolored vertices for which color c is already forbidden
+    for (int d = 0; d < encoding_colors; ++d) {
+        if(d != c and class_size[d] > 0) {
+            mgraph.separate_vertices(v, class_rep(d));
+        }
+    }
+    for (int u : mgraph.vertices) {
+        if(vertex_color[u] == NoColor and val(literal(u, c)) == -1) {
+            mgraph.separate_vertices(u, v);
+        }
+    }
+}
+
+void CadicalAssignmentPropagator::forbid_color(const int v, const int c) {
+    num_forbidden[v]++;
+    if(use_bounds and vertex_color[v] == NoColor and class_size[c] > 0) {
+        //v is not allowed in the color class of c, so it is adjacent to it
+        mgraph.separate_vertices(v, class_rep(c));
+    }
+}
+
+void CadicalAssignmentPropagator::unassign(const int lit) {
+    vals[std::abs(lit)] = 0;
+    num_assigned--;
+    if(std::abs(lit) > highest_x_var) {
+        return;
+    }
+    int v = (std::abs(lit) - 1) / encoding_colors;
+    int c = (std::abs(lit) - 1) % encoding_colors;
+    if(lit < 0) {
+        num_forbidden[v]--;
+    }
+    else if(vertex_color[v] == c) {
+        //the trail is undone in reverse, so v is the last vertex that was added to the class
+        vertex_color[v] = NoColor;
+        class_size[c]--;
+    }
+}
+
+int CadicalAssignmentPropagator::dsatur_literal() const {
+    //choose uncolored vertex with most forbidden colors, break ties by degree
+    int choice = -1;
+    for (int v = 0; v < num_vertices; ++v) {
+        if(vertex_color[v] != NoColor) {
+            continue;
+        }
+        if(choice == -1 or num_forbidden[v] > num_forbidden[choice] or
+            (num_forbidden[v] == num_forbidden[choice] and neighbors[v].size() > neighbors[choice].size())) {
+            choice = v;
+        }
+    }
+    if(choice == -1) {
+        return 0;
+    }
+    //prefer a color that is already used, the unused colors are symmetric so only the smallest of them is tried
+    for (int c = 0; c < num_colors; ++c) {
+        if(class_size[c] > 0 and val(literal(choice, c)) == 0) {
+            DEBUG_PRINT(std::cout << "Dsatur decided on x_" << choice << "," << c << "\n";);
+            return literal(choice, c);
+        }
+    }
+    for (int c = 0; c < num_colors; ++c) {
+        if(val(literal(choice, c)) == 0) {
+            DEBUG_PRINT(std::cout << "Dsatur decided on new color x_" << choice << "," << c << "\n";);
+            return literal(choice, c);
+        }
+    }
+    //no color left for the vertex, the at-least-one clause will cause a conflict
+    return 0;
+}
+
+void CadicalAssignmentPropagator::find_symmetry_propagations() {
+    //x_v,c with c > 0 needs x_u,c-1 for a vertex u before v in the order. while x_u,c-1 is false for the first
+    //vertices of the order, these vertices and the one after them can't have color c
+    check_symmetry = false;
+    std::vector<int> reason;
+    for (int c = 1; c < num_colors; ++c) {
+        reason.clear();
+        for (int v : symmetry_order) {
+            if(val(literal(v, c)) != -1) {
+                propagations.push_back(-literal(v, c));
+                clauses.push_back(reason);
+                clauses.back().push_back(-literal(v, c));
+            }
+            if(val(literal(v, c - 1)) != -1) {
+                break;
+            }
+            reason.push_back(literal(v, c - 1));
+        }
+    }
+}
+
+void CadicalAssignmentPropagator::compute_cliques() {
+    maximal_cliques.clear();
+    num_assignments_last_clique_computation = num_assignments;
+    max_clique_size = mgraph.greedy_cliques(maximal_cliques, options.prop_clique_limit);
+    if (options.mnts_length > 0 and max_clique_size <= num_colors){
+        std::vector<Bitset> mnts_cliques;
+        int mnts_size = mgraph.mnts_clique(*mnts_engine, mnts_cliques, num_colors + 1, mnts_previous_clique);
+        mnts_previous_clique = mnts_cliques.front();
+        if (mnts_size > max_clique_size) {
+            max_clique_size = mnts_size;
+            maximal_cliques = mnts_cliques;
+        }
+    }
+    assert(not maximal_cliques.empty());
+    stats.prop_num_clique_computations++;
+    stats.prop_num_maximal_cliques_computed += static_cast<int>(maximal_cliques.size());
+    if(max_clique_size == num_colors) {
+        stats.prop_num_tight_cliques_computed += static_cast<int>(maximal_cliques.size());
+    }
+}
+
+void CadicalAssignmentPropagator::add_vertex_reason(const int v, std::vector<int> &clause) const {
+    assert(mgraph.vertex_rep[v] == v);
+    if(vertex_color[v] != NoColor) {
+        //the class exists because its representative has the color
+        assert(val(literal(v, vertex_color[v])) == 1);
+        clause.push_back(-literal(v, vertex_color[v]));
+    }
+}
+
+void CadicalAssignmentPropagator::add_edge_reason(int u, int v, std::vector<int> &clause) const {
+    assert(mgraph.has_edge(u, v));
+    if((vertex_color[u] == NoColor) == (vertex_color[v] == NoColor)) {
+        //two classes have different colors, two uncolored vertices are adjacent in the input graph
+        return;
+    }
+    if(vertex_color[u] == NoColor) {
+        std::swap(u, v);
+    }
+    //u is a class and v uncolored, either v has a neighbour with the color of u or that color is forbidden for v
+    const int c = vertex_color[u];
+    for (int w : neighbors[v]) {
+        if(vertex_color[w] == c) {
+            clause.push_back(-literal(w, c));
+            return;
+        }
+    }
+    assert(val(literal(v, c)) == -1);
+    clause.push_back(literal(v, c));
+}
+
+void CadicalAssignmentPropagator::finish_explanation_clause(std::vector<int> &clause) {
+    //the same witness can explain several edges
+    std::sort(clause.begin(), clause.end());
+    clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+    if(guard_literal != 0) {
+        assert(val(guard_literal) == 1);
+        clause.push_back(-guard_literal);
+    }
+    external_clauses.push_back(std::move(clause));
+}
+
+void CadicalAssignmentPropagator::check_for_clique_clauses() {
+    if(maximal_cliques.empty() or num_assignments_last_clique_computation != num_assignments) {
+        compute_cliques();
+    }
+    if(max_clique_size <= num_colors) {
+        return;
+    }
+    //a clique of the contracted graph larger than num_colors can't be colored, explain it by the assignments
+    for(const Bitset &clique : maximal_cliques) {
+        assert(mgraph.is_clique(clique));
+        std::vector<int> clause;
+        for (std::size_t u = clique.find_first(); u != Bitset::npos; u = clique.find_next(u)) {
+            add_vertex_reason(static_cast<int>(u), clause);
+            for (std::size_t v = clique.find_next(u); v != Bitset::npos; v = clique.find_next(v)) {
+                add_edge_reason(static_cast<int>(u), static_cast<int>(v), clause);
+            }
+        }
+        DEBUG_PRINT(std::cout << "Gave explanation for clique " << clique << " of size " << clique.count() << "\n";);
+        finish_explanation_clause(clause);
+        stats.prop_num_clique_successes++;
+    }
+}
+
+void CadicalAssignmentPropagator::check_for_mycielsky_clauses() {
+    if(maximal_cliques.empty() or num_assignments_last_clique_computation != num_assignments) {
+        compute_cliques();
+    }
+    assert(max_clique_size <= num_colors); //otherwise clique pruning would have been done instead
+    int gap = num_colors - max_clique_size;
+    if(gap >= options.mycielsky_threshold) {
+        return;
+    }
+    mgraph.update_mycielsky_cache(mycielsky_cache);
+    for(const Bitset &clique : maximal_cliques) {
+        if(static_cast<std::size_t>(gap) >= stats.mycielsky_calls.size()) {
+            stats.mycielsky_calls.resize(gap + 1, 0);
+        }
+        stats.mycielsky_calls[gap]++;
+        MGraph::SubGraph subgraph(clique);
+        int iterations = mgraph.mycielsky_extension_clique(subgraph, gap + 1, mycielsky_cache);
+        if(iterations <= gap) {
+            continue;
+        }
+        //the mycielski subgraph needs more than num_colors colors, explain it like a clique
+        std::vector<int> clause;
+        for (int u : subgraph.nodes) {
+            add_vertex_reason(u, clause);
+            for (std::size_t v = subgraph.matrix[u].find_next(u); v != Bitset::npos; v = subgraph.matrix[u].find_next(v)) {
+                add_edge_reason(u, static_cast<int>(v), clause);
+            }
+        }
+        finish_explanation_clause(clause);
+        if(static_cast<std::size_t>(gap) >= stats.mycielsky_sucesses.size()) {
+            stats.mycielsky_sucesses.resize(gap + 1, 0);
+        }
+        stats.mycielsky_sucesses[gap]++;
+    }
+}
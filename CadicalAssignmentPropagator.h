@@ -0,0 +1,139 @@
+#ifndef INCSATGC_CADICALASSIGNMENTPROPAGATOR_H
+#define INCSATGC_CADICALASSIGNMENTPROPAGATOR_H
+
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <deque>
+
+#include <boost/dynamic_bitset.hpp>
+#include "cadical.hpp"
+
+#include "GraphMatrix.h"
+#include "Statistics.h"
+
+using Bitset = boost::dynamic_bitset<>;
+
+//declare IncSatGC
+class IncSatGC;
+
+//external propagator for the assignment encoding. only the variables x_v,c and the at-least-one clauses are part of
+//the formula, the different-color and at-most-one constraints are propagated when a vertex gets a color.
+//the partial coloring is kept as a contracted graph with one vertex per color class, so the clique and mycielski
+//bounds of the Zykov propagator can be used on the graph that is left to color
+class CadicalAssignmentPropagator : public CaDiCaL::ExternalPropagator{
+
+public:
+    bool is_lazy = false; // lazy propagator only checks complete assignments
+    bool are_reasons_forgettable = true; // Reason external clauses can be deleted
+    bool is_tainting = true; // The external clauses must trigger restore (unless frozen)
+
+    ~CadicalAssignmentPropagator () override ;
+
+    //callbacks of the ExternalPropagator, see CadicalZykovPropagator.h for their documentation
+    void notify_assignment (const std::vector<int>& lits) override;
+    void notify_new_decision_level () override ;
+    void notify_backtrack (size_t new_level) override ;
+    bool cb_check_found_model (const std::vector<int> &model) override ;
+    int cb_decide () override ;
+    int cb_propagate () override ;
+    int cb_add_reason_clause_lit (int propagated_lit) override ;
+    bool cb_has_external_clause (bool& is_forgettable) override;
+    int cb_add_external_clause_lit () override ;
+
+
+    /*
+     * New section for new data members and functions
+     */
+
+    //need reference to IncSatGC instance to access the graph and its options
+    IncSatGC* INSTANCE; //use raw pointer to not take ownership of the superclass
+    //constructor for an encoding with num_colors_ colors, whose variables x_v,c are the first ones of the solver
+    CadicalAssignmentPropagator(IncSatGC& reference, int num_colors_);
+
+    Statistics& stats;
+    const Options& options;
+
+    int num_vertices;
+    int encoding_colors; //number of colors the encoding was built with
+    int num_colors; //number of colors that are currently allowed, at most encoding_colors
+    //in incremental bottom-up solving the colors num_colors,... are disabled under an assumed guard literal,
+    //the bound clauses are only valid under that assumption and get the negated guard added to them
+    int guard_literal = 0;
+    void update_num_colors(int num_colors_, int guard_literal_);
+    [[nodiscard]] bool guard_is_set() const;
+    int highest_x_var;
+    //x_v,c has index encoding_colors * v + c, +1 for cadical
+    [[nodiscard]] int literal(int v, int c) const { return encoding_colors * v + c + 1; }
+
+    //neighbours in the input graph, used to propagate the different-color constraints
+    std::vector<std::vector<int>> neighbors;
+    //partial coloring given by the true x_v,c, the number of vertices in each color class and its first vertex
+    std::vector<int> vertex_color;
+    std::vector<int> class_size;
+    std::vector<int> class_anchor;
+    [[nodiscard]] int class_rep(int c) const { return mgraph.vertex_rep[class_anchor[c]]; }
+    //number of colors that are forbidden for each vertex, the saturation used in the decisions
+    std::vector<int> num_forbidden;
+    //the input graph with each color class contracted into one vertex, and the classes pairwise adjacent.
+    //only built if bounds are used since it needs a dense adjacency matrix
+    bool use_bounds;
+    MGraph mgraph;
+
+    int num_assigned = 0;
+    int current_level = 0;
+    //store all found propagations and corresponding reason clauses
+    std::deque<int> propagations;
+    std::deque< std::vector<int> > clauses;
+    //once a literal has been propagated, remember the reason clause in literal_to_clause, either positive or negative
+    std::vector<std::vector<int>> literal_to_clause_pos;
+    std::vector<std::vector<int>> literal_to_clause_neg;
+    //store the decisions and propagations done, i.e. the trail
+    std::vector< std::vector<int> > current_trail;
+    //value of each variable, indexed by its cadical index
+    std::vector<signed char> vals;
+    [[nodiscard]] signed char val(int lit) const;
+    static int sign (const int lit) { return (lit > 0) - (lit < 0); } //branchless sign computation
+    //vector in which to store any external clauses we want to add
+    std::vector<std::vector<int>> external_clauses;
+
+    //main functions called when notified of an assignment, and their undo when backtracking
+    void assign_color(int v, int c);
+    void forbid_color(int v, int c);
+    void unassign(int lit);
+    //propagate the literal with the binary reason (reason_lit, propagated_lit)
+    void propagate_binary(int reason_lit, int propagated_lit);
+
+    //DSATUR as decision strategy, the most saturated vertex gets the smallest color that is already used,
+    //or the smallest unused one since these are interchangeable
+    [[nodiscard]] int dsatur_literal() const;
+
+    //value symmetry breaking as in IncSatGC::add_color_ordering, but propagated instead of encoded: a vertex can
+    //only get color c > 0 if an earlier vertex of symmetry_order has color c - 1
+    std::vector<int> symmetry_order;
+    bool check_symmetry = true; //only look for symmetry propagations after the assignment changed
+    void find_symmetry_propagations();
+
+    //functions and fields to compute and store maximal cliques of the contracted graph
+    std::vector<Bitset> maximal_cliques;
+    int max_clique_size = -1;
+    long long num_assignments = 0;
+    long long num_assignments_last_clique_computation = -1;
+    void compute_cliques();
+    std::unique_ptr<MNTS> mnts_engine;
+    Bitset mnts_previous_clique;
+    bool first_call_after_backtrack = false; //only call expensive mycielsky bound after a backtrack
+    MGraph::MycielskyCache mycielsky_cache;
+
+    //explanation of a subgraph of the contracted graph: a true x_v,c for each color class in it,
+    //and for each edge between a class and an uncolored vertex the neighbour with that color or the false x_v,c
+    void add_vertex_reason(int v, std::vector<int> &clause) const;
+    void add_edge_reason(int u, int v, std::vector<int> &clause) const;
+    void finish_explanation_clause(std::vector<int> &clause);
+    void check_for_clique_clauses();
+    void check_for_mycielsky_clauses();
+};
+
+
+#endif //INCSATGC_CADICALASSIGNMENTPROPAGATOR_H
@@ -34,6 +34,14 @@ void CadicalZykovPropagator::notify_assignment(const std::vector<int>& lits) {
                     std::cout << "Was notified of assignment of literal " << lit << " = c_" << (std::abs(lit)  - INSTANCE->c_indices.front())
                           << " at level " << (current_level) << "\n";
                 );
+            if(options.propagate_cardinality_constraints and is_cj_literal(lit)) {
+                if(lit > 0) {
+                    true_cj.push_back(lit);
+                }
+                else {
+                    num_false_cj++;
+                }
+            }
             //do not propagate anything for assignments of cj literals or activation literal
             continue;
         }
@@ -118,6 +126,15 @@ void CadicalZykovPropagator::notify_backtrack(size_t new_level) {
         for(auto l_it = current_trail.back().rbegin(); l_it != current_trail.back().rend(); ++l_it){
             set_val(*l_it, 0);
             num_assigned--;
+            if(options.propagate_cardinality_constraints and is_cj_literal(*l_it)) {
+                if(*l_it > 0) {
+                    assert(true_cj.back() == *l_it);
+                    true_cj.pop_back();
+                }
+                else {
+                    num_false_cj--;
+                }
+            }
         }
         current_trail.pop_back();
         current_level--;
@@ -143,16 +160,24 @@ void CadicalZykovPropagator::notify_backtrack(size_t new_level) {
 bool CadicalZykovPropagator::cb_check_found_model(const std::vector<int> &model) {
     DEBUG_PRINT(std::cout << "EP checked found model\n";);
     assert(clauses.empty());
+    if(options.propagate_cardinality_constraints) {
+        //every assignment was observed so the count should hold, but check the model to be safe
+        std::vector<int> used_cj;
+        for(int var = highest_sij_var + 1; var <= highest_var; ++var) {
+            if(model[var - 1] > 0) {
+                used_cj.push_back(var);
+            }
+        }
+        if(static_cast<int>(used_cj.size()) >= num_colors) {
+            external_clauses.push_back(cardinality_explanation_clause(used_cj, num_colors));
+            return false;
+        }
+    }
     clauses = find_conflicts_in_model(model);
     if(not clauses.empty()){
         std::cout << "cb_check_found_model : false, because checker found conflicts\n";
         throw std::runtime_error("Checked model should be correct?");
     }
-    //model was correct which means a valid coloring was found, compare to time when heuristic found one, if any
-    if(stats.heuristic_found_coloring) {
-        stats.heuristic_theoretical_time_improvement += stats.current_total_time() - stats.heuristic_coloring_time_point;
-        stats.heuristic_found_coloring = false;
-    }
     return true;
 }
 
@@ -176,7 +201,10 @@ int CadicalZykovPropagator::cb_propagate() {
     DEBUG_PRINT(std::cout << "EP was asked if there is an external propagation\n";);
     assert(clauses.size() == propagations.size());
     if(propagations.empty()) {
-        //done with transitivity propagations for now, check if there are prunings to be propagated
+        //done with transitivity propagations for now, check if the color count or prunings propagate something
+        find_cardinality_propagations();
+    }
+    if(propagations.empty()) {
         find_clique_based_pruning();
     }
     while (not propagations.empty()){
@@ -239,6 +267,9 @@ bool CadicalZykovPropagator::cb_has_external_clause(bool& is_forgettable) {
     if(not propagations.empty() or not bottom_up_clique_assumption_variable_is_set()) {
         return false;
     }
+    if(options.propagate_cardinality_constraints) {
+        check_for_cardinality_conflict();
+    }
     if(compute_clique_clauses()) {
         check_for_clique_clauses();
     }
@@ -303,6 +334,14 @@ CadicalZykovPropagator::CadicalZykovPropagator(IncSatGC &reference)
     maximal_cliques = {};
     max_clique_size = {};
     first_call_after_backtrack = false;
+    if(options.use_mycielsky_explanation_clauses) {
+        mycielsky_cache = MGraph::MycielskyCache(num_vertices);
+    }
+    if(options.mnts_length > 0) {
+        mnts_engine = std::make_unique<MNTS>(num_vertices, options.mnts_length, options.mnts_depth);
+        mnts_previous_clique = Bitset(num_vertices);
+    }
+    empty_clique = Bitset(num_vertices);
 
 	//pre-allocate space for some of the stat vectors
 
@@ -797,9 +836,8 @@ void CadicalZykovPropagator::compute_cliques() {
     max_clique_size = mgraph.greedy_cliques(maximal_cliques, options.prop_clique_limit);
     if (options.mnts_length > 0 and max_clique_size <= num_colors){
         std::vector<Bitset> mnts_cliques;
-        int mnts_size = mgraph.mnts_clique(mnts_cliques, num_colors + 1,
-                                options.mnts_length, options.mnts_depth,
-                                static_cast<int>(stats.prop_num_clique_computations)); //use changing but deterministic random seed
+        int mnts_size = mgraph.mnts_clique(*mnts_engine, mnts_cliques, num_colors + 1, mnts_previous_clique);
+        mnts_previous_clique = mnts_cliques.front();
         if (mnts_size > max_clique_size) {
             max_clique_size = mnts_size;
             maximal_cliques = mnts_cliques;
@@ -834,18 +872,73 @@ bool CadicalZykovPropagator::compute_mycielsky_clauses() const {
 }
 
 bool CadicalZykovPropagator::need_bottom_up_clique_assumption_variable() const {
-    return options.strategy == Options::BottomUp
+    //the bound clauses only hold for the current num_colors if it can increase later
+    return (options.strategy == Options::BottomUp or options.strategy == Options::Bisection)
             and (options.use_clique_explanation_clauses
+                or options.propagate_cardinality_constraints
                 or options.enable_positive_pruning
                 or options.enable_negative_pruning);
 }
 
 bool CadicalZykovPropagator::bottom_up_clique_assumption_variable_is_set() const {
     //either don't care about activation literal or ceck that it is assigned
-    assert(options.strategy != Options::BottomUp or bottom_up_clique_assumption_variable > 0);
-    assert(options.strategy != Options::BottomUp or bottom_up_clique_assumption_variable <= max_var);
+    assert(not need_bottom_up_clique_assumption_variable() or bottom_up_clique_assumption_variable > 0);
+    assert(not need_bottom_up_clique_assumption_variable() or bottom_up_clique_assumption_variable <= max_var);
     //can potentially be 1 too after fixing it via unit clause, then just return that it is not set (to what we need)
-    return options.strategy != Options::BottomUp or val(bottom_up_clique_assumption_variable) == -1;
+    return not need_bottom_up_clique_assumption_variable() or val(bottom_up_clique_assumption_variable) == -1;
+}
+
+bool CadicalZykovPropagator::is_cj_literal(int lit) const {
+    //the c_j follow directly after the s_ij variables
+    return std::abs(lit) > highest_sij_var and std::abs(lit) <= highest_var;
+}
+
+void CadicalZykovPropagator::find_cardinality_propagations() {
+    if(not options.propagate_cardinality_constraints or not bottom_up_clique_assumption_variable_is_set()) {
+        return;
+    }
+    const int max_true_cj = num_colors - 1;
+    //only propagate if exactly the allowed number of color classes is started and some c_j are still open,
+    //too many true c_j are a conflict that is added as external clause instead
+    if(static_cast<int>(true_cj.size()) != max_true_cj
+        or static_cast<int>(true_cj.size()) + num_false_cj == highest_var - highest_sij_var) {
+        return;
+    }
+    const std::vector<int> explanation = cardinality_explanation_clause(true_cj, max_true_cj);
+    for(int var = highest_sij_var + 1; var <= highest_var; ++var) {
+        if(val(var) != 0) {
+            continue;
+        }
+        //all colors are used, vertex j can not start a new color class: (-c_j or OR -c_t for the true c_t)
+        std::vector<int> clause = explanation;
+        clause.push_back(-var);
+        propagations.push_back(-var);
+        clauses.push_back(std::move(clause));
+        stats.prop_num_cardinality_propagations++;
+    }
+}
+
+void CadicalZykovPropagator::check_for_cardinality_conflict() {
+    if(static_cast<int>(true_cj.size()) >= num_colors) {
+        DEBUG_PRINT(std::cout << "Found " << true_cj.size() << " true c_j for " << num_colors << " colors\n";);
+        external_clauses.push_back(cardinality_explanation_clause(true_cj, num_colors));
+    }
+}
+
+std::vector<int> CadicalZykovPropagator::cardinality_explanation_clause(const std::vector<int> &used_cj, int size) const {
+    assert(size <= static_cast<int>(used_cj.size()));
+    std::vector<int> clause;
+    clause.reserve(size + 2);
+    if(need_bottom_up_clique_assumption_variable()) {
+        assert(bottom_up_clique_assumption_variable > 0);
+        //bound only holds for the current num_colors, deactivated later with the assumption variable
+        clause.push_back(bottom_up_clique_assumption_variable);
+    }
+    //not all of the first size true c_j can be true together
+    for(int i = 0; i < size; ++i) {
+        clause.push_back(-used_cj[i]);
+    }
+    return clause;
 }
 
 std::vector<int> CadicalZykovPropagator::clique_explanation_clause(const Bitset &clique) const {
@@ -919,6 +1012,7 @@ void CadicalZykovPropagator::check_for_mycielsky_clauses() {
     assert(max_clique_size <= num_colors); //otherwise clique pruning would have been done instead
     int gap = num_colors - max_clique_size;
     if(gap < options.mycielsky_threshold) {
+        mgraph.update_mycielsky_cache(mycielsky_cache);
         for(const auto & clique : maximal_cliques) {
             if(gap >= stats.mycielsky_calls.size()) {
                 stats.mycielsky_calls.resize(gap + 1, 0);
@@ -927,7 +1021,7 @@ void CadicalZykovPropagator::check_for_mycielsky_clauses() {
             //start algorithm with clique subgraph; given as bitset and build graph from that
             MGraph::SubGraph subgraph(clique);
             //try to extend subgraph to next generalised mycielsky, need at least gap + 1 succesful iterations
-            int iterations = mgraph.mycielsky_extension_clique(subgraph, gap + 1);
+            int iterations = mgraph.mycielsky_extension_clique(subgraph, gap + 1, mycielsky_cache);
             if(iterations > gap) { //only explain subgraph if the proven bound was good enough to cross threshold
                 assert(iterations == gap + 1);
                 //graph is too large and one edge should have been contracted instead, add the reason clause for this
@@ -1160,33 +1254,54 @@ bool CadicalZykovPropagator::compute_coloring() const {
             and num_assigned > INSTANCE->encoder_assumptions.size();
 }
 
-void CadicalZykovPropagator::check_for_coloring() const {
-    //try to compute better coloring on changed graph, only returns size and coloring is not used
+void CadicalZykovPropagator::check_for_coloring() {
+    //try to compute better coloring on the graph of the current zykov node
     PROP_TIMING(stats.start_phase(Statistics::TestColorTime););
     int coloring_size = stats.upper_bound;
+    std::vector<int> &vertex_colors = node_coloring; //colors of the remaining vertices, -1 for contracted ones
     switch (options.zykov_coloring_algorithm) {
         case Options::FastDsatur:
-            coloring_size = mgraph.dsatur_coloring((maximal_cliques.empty() ? Bitset(num_vertices) : maximal_cliques.front()));
+            coloring_size = mgraph.dsatur_coloring((maximal_cliques.empty() ? empty_clique : maximal_cliques.front()), vertex_colors);
             break;
         case Options::SortedSEQ:
-            coloring_size = mgraph.sequential_coloring((maximal_cliques.empty() ? Bitset(num_vertices) : maximal_cliques.front()));
+            coloring_size = mgraph.sequential_coloring((maximal_cliques.empty() ? empty_clique : maximal_cliques.front()), vertex_colors);
             break;
         case Options::IteratedIS:
-            coloring_size = mgraph.IS_extract((maximal_cliques.empty() ? Bitset(num_vertices) : maximal_cliques.front()));
+            coloring_size = mgraph.IS_extract((maximal_cliques.empty() ? empty_clique : maximal_cliques.front()), vertex_colors);
             break;
         case Options::IteratedSEQ:
-            coloring_size = mgraph.ISEQ();
+            coloring_size = mgraph.ISEQ(vertex_colors);
             break;
         case Options::None:
             throw std::runtime_error("Should have previously checked that no coloring algorithm was to be used.");
     }
 
     if(coloring_size <= num_colors) {
-        std::cout << "Found an improved coloring using " << coloring_size << " colors!!!!! at " << INSTANCE->stats.current_total_time()
-        << " density of " << mgraph.density() <<"\n";
-        if(not stats.heuristic_found_coloring) { //only update first time coloring is found
-            stats.heuristic_found_coloring = true;
-            stats.heuristic_coloring_time_point = stats.current_total_time();
+        //every vertex gets the color of the representative of its bag, renumbering colors in case some class is empty
+        ColorMap colors(num_vertices);
+        std::vector<int> new_color(coloring_size + 1, -1);
+        int num_used_colors = 0;
+        for (int v = 0; v < num_vertices; ++v) {
+            int color = vertex_colors[mgraph.vertex_rep[v]];
+            assert(0 <= color and color < static_cast<int>(new_color.size()));
+            if (new_color[color] == -1) {
+                new_color[color] = num_used_colors++;
+            }
+            colors[v] = new_color[color];
+        }
+        //the contracted graph only adds edges and merges non-adjacent vertices, so this is a coloring of the graph,
+        //the solver is stopped and the coloring is used as if it was the model for this number of colors
+        bool is_new_best = INSTANCE->search_coloring.empty() or
+                           num_used_colors <= *std::max_element(INSTANCE->search_coloring.begin(), INSTANCE->search_coloring.end());
+        if (is_new_best and INSTANCE->is_valid_coloring(colors)) {
+            stats.prop_num_search_colorings++;
+            if (options.verbosity >= Options::Verbose) {
+                std::cout << "c Propagator: coloring heuristic found a " << num_used_colors << "-coloring at level "
+                          << current_level << ", stopping the current SAT call at " << stats.current_total_time() << "\n";
+            }
+            INSTANCE->search_coloring = std::move(colors);
+            auto solver = std::dynamic_pointer_cast<CaDiCaLAdaptor::Solver>(INSTANCE->solver);
+            solver->solver.terminate();
         }
     }
     PROP_TIMING(stats.end_phase(Statistics::TestColorTime););
@@ -1219,10 +1334,9 @@ void CadicalZykovPropagator::check_for_fractional_bound() {
     stats.fractional_bound_calls++;
     auto start = Statistics::cpuTime();
     //build graph on which to compute bound
-    std::vector<int> index_mapping;
-    std::vector<Bitset> active_subgraph = mgraph.get_active_subgraph(index_mapping);
+    mgraph.get_active_subgraph(active_subgraph_buffer, active_index_mapping);
     //compute bound
-    double frac = fractional_chromatic_number_exactcolors(active_subgraph);
+    double frac = fractional_chromatic_number_exactcolors(active_subgraph_buffer);
     auto total = Duration(Statistics::cpuTime() - start);
     stats.full_fractional_time += total;
 
@@ -228,18 +228,31 @@ public:
     std::vector<Bitset> maximal_cliques;
     int max_clique_size;
     void compute_cliques();
+    //mnts engine kept over the whole search, it is started from the clique it found at the previous node
+    std::unique_ptr<MNTS> mnts_engine;
+    Bitset mnts_previous_clique;
     [[nodiscard]] bool need_to_recompute_cliques() const;
     //some helper functions to determine whether cliques need to be recomputed and which bounds we compute
     long long num_assignments_last_clique_computation = 0; //need to recompute cliques if assignments were done
     [[nodiscard]] bool compute_clique_clauses() const;
     [[nodiscard]] bool compute_mycielsky_clauses() const;
     bool first_call_after_backtrack; //only call expensive mycielsky bound after a backtrack
+    MGraph::MycielskyCache mycielsky_cache; //S_v sets kept between calls of the mycielsky extension
     //for cliques to not mess up the bottom-up approach,
     //we need an activation literal to disable clauses for cliques of smaller sizer later on
     int bottom_up_clique_assumption_variable = 0;
     [[nodiscard]] bool need_bottom_up_clique_assumption_variable() const;
     [[nodiscard]] bool bottom_up_clique_assumption_variable_is_set() const;
 
+    //at most num_colors - 1 of the c_j can be true since vertex 0 always starts a color class.
+    //counted here instead of a cardinality encoding, the true c_j are kept in trail order for the explanations
+    std::vector<int> true_cj;
+    int num_false_cj = 0;
+    [[nodiscard]] bool is_cj_literal(int lit) const;
+    void find_cardinality_propagations();
+    void check_for_cardinality_conflict();
+    [[nodiscard]] std::vector<int> cardinality_explanation_clause(const std::vector<int> &used_cj, int size) const;
+
     //helper function to put clique explanation into a vector
     [[nodiscard]] std::vector<int> clique_explanation_clause(const Bitset &clique) const;
     //function that checks cliques for being of size > num_colors, and adds their explanation
@@ -261,13 +274,18 @@ public:
     void find_edge_additions();
     void find_clique_based_pruning();
 
-    //functions to look for a coloring on graph of current node in Zykov tree
+    //functions to look for a coloring on graph of current node in Zykov tree,
+    //a coloring with at most num_colors colors is handed to INSTANCE and the SAT call is stopped
     [[nodiscard]] bool compute_coloring() const;
-    void check_for_coloring() const;
+    void check_for_coloring();
+    std::vector<int> node_coloring; //buffer for the coloring of the current node
+    Bitset empty_clique; //used as clique if none was computed yet
 
     //function to compute the fractional chromatic number as bound and check if it should be executed
     [[nodiscard]] bool compute_fractional_bound() const;
     void check_for_fractional_bound();
+    std::vector<Bitset> active_subgraph_buffer; //graph of the current node, reused between calls
+    std::vector<int> active_index_mapping;
     bool flag_fractional_timed_out;
 
 };
@@ -0,0 +1,127 @@
+#include "ClauseWriter.h"
+
+
+ClauseWriter::ClauseWriter(const std::string &filename, const bool compress) : filename(filename), buffer(buffer_size) {
+    if (compress) {
+        compressed_file = gzopen(filename.c_str(), "wb");
+    }
+    else {
+        file = std::fopen(filename.c_str(), "wb");
+    }
+    if (not file and not compressed_file) {
+        throw std::runtime_error("Could not open file " + filename + " to write clauses.");
+    }
+}
+
+ClauseWriter::~ClauseWriter() {
+    //errors can't be reported from the destructor, close() has to be called to check them
+    if (file or compressed_file) {
+        try {
+            flush();
+        } catch (...) {}
+        if (file) {
+            std::fclose(file);
+        }
+        if (compressed_file) {
+            gzclose(compressed_file);
+        }
+    }
+}
+
+void ClauseWriter::comment(const std::string &text) {
+    write("c ", 2);
+    write(text.data(), text.size());
+    write("\n", 1);
+}
+
+void ClauseWriter::cnf_header(const int num_vars, const long long num_clauses) {
+    num_declared_clauses = num_clauses;
+    write("p cnf ", 6);
+    put(num_vars, ' ');
+    put(num_clauses, '\n');
+}
+
+void ClauseWriter::wcnf_header(const int num_vars, const long long num_clauses, const long long top) {
+    is_wcnf = true;
+    num_declared_clauses = num_clauses;
+    write("p wcnf ", 7);
+    put(num_vars, ' ');
+    put(num_clauses, ' ');
+    put(top, '\n');
+}
+
+void ClauseWriter::clause(const int *literals, const std::size_t size, const long long weight) {
+    if (is_wcnf) {
+        put(weight, ' ');
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+        put(literals[i], ' ');
+    }
+    put(0, '\n');
+    num_written_clauses++;
+}
+
+void ClauseWriter::clause(const std::initializer_list<int> literals, const long long weight) {
+    clause(literals.begin(), literals.size(), weight);
+}
+
+void ClauseWriter::clauses(const std::vector<int> &literals, const long long weight) {
+    std::size_t begin = 0;
+    for (std::size_t end = 0; end < literals.size(); ++end) {
+        if (literals[end] == 0) {
+            clause(literals.data() + begin, end - begin, weight);
+            begin = end + 1;
+        }
+    }
+}
+
+void ClauseWriter::close() {
+    flush();
+    bool failed;
+    if (file) {
+        failed = std::fclose(file) != 0;
+        file = nullptr;
+    }
+    else {
+        failed = gzclose(compressed_file) != Z_OK;
+        compressed_file = nullptr;
+    }
+    if (failed) {
+        throw std::runtime_error("Could not finish writing clauses to " + filename + ".");
+    }
+    if (num_declared_clauses != -1 and num_declared_clauses != num_written_clauses) {
+        throw std::runtime_error("Header of " + filename + " declares " + std::to_string(num_declared_clauses)
+                                 + " clauses but " + std::to_string(num_written_clauses) + " were written.");
+    }
+}
+
+void ClauseWriter::flush() {
+    if (buffer_used == 0) {
+        return;
+    }
+    bool failed;
+    if (file) {
+        failed = std::fwrite(buffer.data(), 1, buffer_used, file) != buffer_used;
+    }
+    else {
+        failed = gzwrite(compressed_file, buffer.data(), static_cast<unsigned int>(buffer_used))
+                 != static_cast<int>(buffer_used);
+    }
+    buffer_used = 0;
+    if (failed) {
+        throw std::runtime_error("Could not write clauses to " + filename + ".");
+    }
+}
+
+void ClauseWriter::write(const char *text, std::size_t size) {
+    while (size > 0) {
+        if (buffer_used == buffer_size) {
+            flush();
+        }
+        std::size_t chunk = std::min(size, buffer_size - buffer_used);
+        std::copy(text, text + chunk, buffer.data() + buffer_used);
+        buffer_used += chunk;
+        text += chunk;
+        size -= chunk;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef INCSATGC_CLAUSEWRITER_H
+#define INCSATGC_CLAUSEWRITER_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <charconv>
+#include <algorithm>
+#include <stdexcept>
+#include <initializer_list>
+
+#include <zlib.h> //compressed output
+
+//writes cnf and wcnf files in dimacs format, clauses are formatted into a large buffer that is only written
+//to the file (or through zlib into a .gz file) when it is full, instead of one stream operation per integer
+//the number of clauses declared in the header is checked against the written clauses when closing
+class ClauseWriter {
+public:
+    ClauseWriter(const std::string &filename, bool compress);
+    ~ClauseWriter();
+    ClauseWriter(const ClauseWriter &) = delete;
+    ClauseWriter &operator=(const ClauseWriter &) = delete;
+
+    void comment(const std::string &text);
+    void cnf_header(int num_vars, long long num_clauses);
+    //hard clauses are the ones with weight top
+    void wcnf_header(int num_vars, long long num_clauses, long long top);
+
+    //weight is only written for wcnf files
+    void clause(const int *literals, std::size_t size, long long weight = 0);
+    void clause(std::initializer_list<int> literals, long long weight = 0);
+    //several clauses given as literals where every clause ends with 0, all with the same weight
+    void clauses(const std::vector<int> &literals, long long weight = 0);
+
+    //flushes the buffer and closes the file, throws if writing failed or the header did not match
+    void close();
+
+    [[nodiscard]] long long get_num_clauses() const { return num_written_clauses; }
+
+private:
+    static constexpr std::size_t buffer_size = 1 << 20;
+    //longest text of one number with its separator
+    static constexpr std::size_t max_number_length = 24;
+
+    std::string filename;
+    std::FILE *file = nullptr;
+    gzFile compressed_file = nullptr;
+    std::vector<char> buffer;
+    std::size_t buffer_used = 0;
+    bool is_wcnf = false;
+    long long num_declared_clauses = -1;
+    long long num_written_clauses = 0;
+
+    void flush();
+    void write(const char *text, std::size_t size);
+    void put(long long number, char separator) {
+        if (buffer_used + max_number_length > buffer_size) {
+            flush();
+        }
+        char *end = std::to_chars(buffer.data() + buffer_used, buffer.data() + buffer_size, number).ptr;
+        *end = separator;
+        buffer_used = end + 1 - buffer.data();
+    }
+};
+
+
+#endif //INCSATGC_CLAUSEWRITER_H
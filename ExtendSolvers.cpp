@@ -21,6 +21,14 @@ bool CaDiCaLAdaptor::Solver::addClause_(NSPACE::vec<NSPACE::Lit> &ps) {
     return true;
 }
 
+void CaDiCaLAdaptor::Solver::add_clauses(const std::vector<int> &literals) {
+    //literals are already in cadical format, hand them over without converting
+    for (int lit : literals) {
+        solver.add(lit);
+        num_clauses += (lit == 0);
+    }
+}
+
 void CaDiCaLAdaptor::Solver::assume(const NSPACE::vec<NSPACE::Lit> &assumps) {
     //add assumptions from a vec of lits, used for the assumptions we get from the cardinality constraints
     for (int i = 0; i < assumps.size(); i++) {
@@ -31,6 +39,10 @@ void CaDiCaLAdaptor::Solver::assume(const NSPACE::vec<NSPACE::Lit> &assumps) {
     }
 }
 
+void CaDiCaLAdaptor::Solver::phase(NSPACE::Lit lit) {
+    solver.phase(LitToVar(lit));
+}
+
 void CaDiCaLAdaptor::Solver::newVars(int num_vars) {
     //reserve space for new vars in cadical solver
     solver.reserve(solver.vars() + num_vars);
@@ -2,6 +2,8 @@
 #define INCSATGC_EXTENDSOLVERS_H
 
 
+#include <vector>
+
 #include "core/Solver.h"
 #include "cadical.hpp"
 
@@ -16,7 +18,11 @@ namespace CaDiCaLAdaptor {
         static int LitToVar(NSPACE::Lit &lit);
         //overrides addClause_ so that the clauses are added to underlying cadical solver
         bool addClause_(NSPACE::vec<NSPACE::Lit>& ps) override;
+        //adds clauses given as cadical literals, each clause terminated by 0
+        void add_clauses(const std::vector<int> &literals);
         void assume(const NSPACE::vec<NSPACE::Lit> &assumps);
+        //sets the phase cadical uses when deciding the variable of lit
+        void phase(NSPACE::Lit lit);
         //no need to override newVar as cadical adds new vars on the fly as needed
 
         //make new function to add many variables at once
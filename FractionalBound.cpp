@@ -1,6 +1,10 @@
 #include "FractionalBound.h"
 
+//exactcolors has global state and stdout is redirected below, so only one call can run at a time
+static std::mutex exactcolors_mutex;
+
 double fractional_chromatic_number_exactcolors(const std::vector<Bitset>& adj){
+    std::lock_guard<std::mutex> lock(exactcolors_mutex);
     fflush(nullptr);  // flush all stdio buffers
     int saved_out  = dup(STDOUT_FILENO);
     int saved_err  = dup(STDERR_FILENO);
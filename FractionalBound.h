@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <cfenv>
 #include <iomanip>
+#include <mutex>
 
 #include "GraphMatrix.h"
 
@@ -136,6 +136,43 @@ Graph Graph::get_complement() const {
     return {_ncount, complement_ecount,  complement_elist()};
 }
 
+CompactNeighborList Graph::get_complement_neighbor_list() const {
+    //merge each sorted neighbor list with all vertices, the complement lists are sorted as well
+    NeighborList neighbors = get_neighbor_list();
+    CompactNeighborList complement;
+    complement.offsets.resize(_ncount + 1, 0);
+    for(VertexType v = 0; v < _ncount; v++){
+        long long num_non_neighbors = (_ncount - 1) - static_cast<long long>(neighbors[v].size());
+        //duplicate edges or loops can give more neighbors than vertices, otherwise they are caught while merging
+        if(num_non_neighbors < 0){
+            throw std::runtime_error("Did not produce the right amount of complement edges.");
+        }
+        complement.offsets[v + 1] = complement.offsets[v] + num_non_neighbors;
+    }
+    complement.neighbors.resize(complement.offsets.back());
+    for(VertexType v = 0; v < _ncount; v++){
+        long long next = complement.offsets[v];
+        auto next_neighbor = neighbors[v].begin();
+        for (VertexType w = 0; w < _ncount; ++w) {
+            if (next_neighbor != neighbors[v].end() and *next_neighbor == w) {
+                ++next_neighbor;
+            }
+            else if (w != v) {
+                if(next == complement.offsets[v + 1]){
+                    throw std::runtime_error("Did not produce the right amount of complement edges.");
+                }
+                complement.neighbors[next++] = w;
+            }
+        }
+        if(next != complement.offsets[v + 1] or next_neighbor != neighbors[v].end()){
+            throw std::runtime_error("Did not produce the right amount of complement edges.");
+        }
+        //free the neighbors early, only the complement is kept
+        NeighborList::value_type().swap(neighbors[v]);
+    }
+    return complement;
+}
+
 
 Graph::Graph(const char *filename) : _ncount(0), _ecount(0) {
     std::string string_name = filename;
@@ -348,123 +385,195 @@ Coloring Graph::dsatur(Permutation &ordering, const std::vector<VertexType> &cli
 }
 
 Coloring Graph::dsatur(Permutation &ordering, const NeighborList &neighbors, const std::vector<VertexType> &clique) const {
+    return to_coloring(dsatur_color_map(ordering, neighbors, clique));
+}
+
+namespace {
+//max heap on the uncolored vertices for dsatur, ordered by saturation, then degree, then tiebreak value
+class SaturationHeap {
+public:
+    SaturationHeap(const std::vector<int> &saturation, const std::vector<int> &degree, const std::vector<int> &tiebreak)
+        : saturation(saturation), degree(degree), tiebreak(tiebreak), position(saturation.size(), -1) {}
+
+    [[nodiscard]] bool empty() const { return heap.empty(); }
+    [[nodiscard]] bool contains(VertexType v) const { return position[v] != -1; }
+
+    void push(VertexType v) {
+        position[v] = static_cast<int>(heap.size());
+        heap.push_back(v);
+        sift_up(position[v]);
+    }
+
+    VertexType pop() {
+        VertexType top = heap.front();
+        swap_entries(0, static_cast<int>(heap.size()) - 1);
+        heap.pop_back();
+        position[top] = -1;
+        if (not heap.empty()) sift_down(0);
+        return top;
+    }
+
+    //restore heap order after the key of v changed in either direction
+    void update(VertexType v) {
+        sift_up(position[v]);
+        sift_down(position[v]);
+    }
+
+private:
+    const std::vector<int> &saturation;
+    const std::vector<int> &degree;
+    const std::vector<int> &tiebreak;
+    std::vector<VertexType> heap;
+    std::vector<int> position;
+
+    [[nodiscard]] bool before(VertexType v, VertexType w) const {
+        if (saturation[v] != saturation[w]) return saturation[v] > saturation[w];
+        if (degree[v] != degree[w]) return degree[v] > degree[w];
+        return tiebreak[v] > tiebreak[w];
+    }
+
+    void swap_entries(int i, int j) {
+        std::swap(heap[i], heap[j]);
+        position[heap[i]] = i;
+        position[heap[j]] = j;
+    }
+
+    void sift_up(int i) {
+        while (i > 0 and before(heap[i], heap[(i - 1) / 2])) {
+            swap_entries(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void sift_down(int i) {
+        int size = static_cast<int>(heap.size());
+        while (true) {
+            int best = i;
+            for (int child = 2 * i + 1; child <= 2 * i + 2 and child < size; ++child) {
+                if (before(heap[child], heap[best])) best = child;
+            }
+            if (best == i) return;
+            swap_entries(i, best);
+            i = best;
+        }
+    }
+};
+}
+
+ColorMap Graph::dsatur_color_map(Permutation &ordering, const std::vector<VertexType> &clique) const {
+    NeighborList neighbors = get_neighbor_list();
+    return dsatur_color_map(ordering, neighbors, clique);
+}
+
+ColorMap Graph::dsatur_color_map(Permutation &ordering, const NeighborList &neighbors,
+                                 const std::vector<VertexType> &clique) const {
     ordering.clear();
     ordering.reserve(_ncount);
-    Coloring coloring;
-    //initialise all vertices to be uncolored and have zero saturation
-    std::vector<int> vertex_color(_ncount, -1);
-    //record for an uncolored vertex to how many colored vertices it is connected to
+    ColorMap vertex_color(_ncount, -1);
+    int num_colors = 0;
+    //saturation level is the number of distinct colors in the neighborhood, those colors are marked in a bitset
     std::vector<int> saturation_level(_ncount, 0);
+    std::vector<std::vector<bool>> neighbor_colors(_ncount);
+    std::vector<int> degree(_ncount);
+    std::vector<int> tiebreak(_ncount);
+    for (VertexType v = 0; v < _ncount; ++v) {
+        degree[v] = static_cast<int>(neighbors[v].size());
+        //without randomness prefer the smallest label, as the scanning implementation did
+        tiebreak[v] = -v;
+    }
+    if (random_tiebreaks) {
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        std::shuffle(tiebreak.begin(), tiebreak.end(), gen);
+    }
+    SaturationHeap uncolored(saturation_level, degree, tiebreak);
+
+    //mark color for all uncolored neighbors of v and update their position in the heap
+    auto add_neighbor_color = [&](VertexType v, int color) {
+        for (VertexType neighbor : neighbors[v]) {
+            if (vertex_color[neighbor] != -1) continue;
+            std::vector<bool> &colors = neighbor_colors[neighbor];
+            if (static_cast<int>(colors.size()) <= color) colors.resize(color + 1, false);
+            if (not colors[color]) {
+                colors[color] = true;
+                saturation_level[neighbor]++;
+                if (uncolored.contains(neighbor)) uncolored.update(neighbor);
+            }
+        }
+    };
 
-    int nclique_colors = 0;
     if(clique.size() > 2){//ignore trivial or empty clique
         //fix color of the vertices of supplied clique and set saturation levels
-        int color_index = 0;
         for(VertexType v : clique){
             ordering.push_back(v);
-            coloring.emplace_back(); //new color class
-            coloring[color_index].insert(v); //assign first color to max degree vertex
-            vertex_color[v] = color_index;
-            color_index++;
-            //update saturation levels
-            for(VertexType neighbor : neighbors[v]){
-                saturation_level[neighbor]++;
-            }
-            saturation_level[v] = std::numeric_limits<int>::min();
+            vertex_color[v] = num_colors;
+            add_neighbor_color(v, num_colors);
+            num_colors++;
         }
-        nclique_colors = int(clique.size());
+    }
+    for (VertexType v = 0; v < _ncount; ++v) {
+        if (vertex_color[v] == -1) uncolored.push(v);
     }
 
-    //main loop looking for the next vertex according to its saturation level
-   for(int iteration = 0; iteration < _ncount - nclique_colors; iteration++){
-        VertexType max_saturated_vertex = 0;
-        int max_saturated = -1;
-        //keep set of tied vertices to later choose one at random
-        std::vector<VertexType> saturated_tied_max_degrees;
-        for(VertexType vertex = 0; vertex < _ncount; vertex++){
-            if(vertex_color[vertex] != -1)
-                continue;
-
-            if(saturation_level[vertex] > max_saturated){
-                //found vertex with higher saturation, update
-                max_saturated = saturation_level[vertex];
-                max_saturated_vertex = vertex;
-
-                saturated_tied_max_degrees.clear();
-                saturated_tied_max_degrees.push_back(vertex);
-            } else if(saturation_level[vertex] == max_saturated){
-                if(neighbors[vertex].size() > neighbors[max_saturated_vertex].size()){
-                    //found vertex with equal saturation but higher degree, update
-                    max_saturated_vertex = vertex;
-
-                    saturated_tied_max_degrees.clear();
-                    saturated_tied_max_degrees.push_back(vertex);
-                } else if(neighbors[vertex].size() == neighbors[max_saturated_vertex].size()){
-                    //same saturation level, same degree, add to set of possible candidates
-                    saturated_tied_max_degrees.push_back(vertex);
-                }
-            }
-        }
-        //select max saturated vertex, at random if there exist multiple
-        if(saturated_tied_max_degrees.size() > 1 and random_tiebreaks){
-            max_saturated_vertex = random_element(saturated_tied_max_degrees);
-        }
+    //main loop taking the vertex with the highest saturation level
+    while (not uncolored.empty()) {
+        VertexType max_saturated_vertex = uncolored.pop();
         ordering.push_back(max_saturated_vertex);
 
-       int lowest_color = 0;
-       bool failed;
-       do {
-           failed = false;
-           for (VertexType neighbor : neighbors[max_saturated_vertex]) {
-               if (vertex_color[neighbor] == lowest_color) {
-                   ++lowest_color;
-                   failed = true;
-                   break;
-               }
-           }
-       } while (failed);
-
+        //smallest color not used in the neighborhood
+        const std::vector<bool> &used = neighbor_colors[max_saturated_vertex];
+        int lowest_color = 0;
+        while (lowest_color < static_cast<int>(used.size()) and used[lowest_color]) {
+            ++lowest_color;
+        }
 
-        if(lowest_color < int(coloring.size())){
+        if (lowest_color < num_colors) {
             //we can add chosen vertex to some existing color class
-            coloring[lowest_color].insert(max_saturated_vertex);
             vertex_color[max_saturated_vertex] = lowest_color;
-        } else if(lowest_color == int(coloring.size())){
-            //new color class is created for max_saturated_vertex
-            //before that we try to recolor two vertices to not have to use a new color
-            bool recolored = try_color_swap(max_saturated_vertex, neighbors, coloring, vertex_color);
-            if(not recolored){
-                //not able to recolor, add new color class
-                coloring.emplace_back();
-                coloring[lowest_color].insert(max_saturated_vertex);
-                vertex_color[max_saturated_vertex] = lowest_color;
-            }
-        } else{
-            std::cout << "Error: lowest color is too high, something must have gone wrong.\n";
-            throw std::runtime_error("Error in Dsatur coloring");
+            add_neighbor_color(max_saturated_vertex, lowest_color);
+            continue;
         }
-
-        //new vertex has been selected so update the saturation levels of all its neighbors if it's a different color
-        int msv_color = vertex_color[max_saturated_vertex];
-        for(VertexType vertex : neighbors[max_saturated_vertex]){
-            bool is_new_color = true;
-            //possibly check that neighbor has been selected, i.e. it's level is equal to numeric_limits<int>::min()
-            if(saturation_level[vertex] != std::numeric_limits<int>::min()){
-                for(VertexType adj_vertex : neighbors[vertex]){
-                    if(adj_vertex != max_saturated_vertex and vertex_color[adj_vertex] == msv_color){
-                        //found neighbor of neighbor that uses msv color, so we don't increase the saturation level
-                        is_new_color = false;
-                        break;
+        //new color class is created for max_saturated_vertex
+        //before that we try to recolor two vertices to not have to use a new color
+        VertexType swapped_vertex;
+        if (try_color_swap(max_saturated_vertex, neighbors, vertex_color, num_colors, swapped_vertex)) {
+            add_neighbor_color(max_saturated_vertex, vertex_color[max_saturated_vertex]);
+            //swapped vertex changed its color, its old color may have vanished from the neighborhoods
+            for (VertexType neighbor : neighbors[swapped_vertex]) {
+                if (vertex_color[neighbor] != -1) continue;
+                std::vector<bool> &colors = neighbor_colors[neighbor];
+                std::fill(colors.begin(), colors.end(), false);
+                saturation_level[neighbor] = 0;
+                for (VertexType w : neighbors[neighbor]) {
+                    int color = vertex_color[w];
+                    if (color == -1) continue;
+                    if (static_cast<int>(colors.size()) <= color) colors.resize(color + 1, false);
+                    if (not colors[color]) {
+                        colors[color] = true;
+                        saturation_level[neighbor]++;
                     }
                 }
-                if(is_new_color)
-                    saturation_level[vertex]++;
+                uncolored.update(neighbor);
             }
+        } else {
+            //not able to recolor, add new color class
+            vertex_color[max_saturated_vertex] = num_colors;
+            add_neighbor_color(max_saturated_vertex, num_colors);
+            num_colors++;
         }
-        //remove selected vertex from any further consideration
-        saturation_level[max_saturated_vertex] = std::numeric_limits<int>::min();
     }
     //colored all vertices
+    return vertex_color;
+}
+
+Coloring Graph::to_coloring(const ColorMap &color_map) {
+    int num_colors = color_map.empty() ? 0 : *std::max_element(color_map.begin(), color_map.end()) + 1;
+    Coloring coloring(num_colors);
+    for (VertexType v = 0; v < static_cast<int>(color_map.size()); ++v) {
+        assert(color_map[v] >= 0);
+        //vertices come in increasing order, so inserting at the end is constant time
+        coloring[color_map[v]].insert(coloring[color_map[v]].end(), v);
+    }
     return coloring;
 }
 
@@ -869,6 +978,39 @@ bool Graph::try_color_swap(VertexType max_saturated_vertex, const NeighborList &
 }
 
 
+bool Graph::try_color_swap(VertexType max_saturated_vertex, const NeighborList &neighbors, ColorMap &vertex_color,
+                           const int num_colors, VertexType &swapped_vertex) {
+    //same swap as for color classes: v has a single neighbor u of color j and u has no neighbor of a later color k,
+    //then v gets color j and u color k
+    std::vector<int> count(num_colors, 0);
+    std::vector<VertexType> unique_neighbor(num_colors, UndefVertex);
+    for (VertexType neighbor : neighbors[max_saturated_vertex]) {
+        int color = vertex_color[neighbor];
+        if (color == -1) continue;
+        count[color]++;
+        unique_neighbor[color] = neighbor;
+    }
+    std::vector<bool> u_neighbor_colors(num_colors);
+    for (int j = 0; j < num_colors; j++) {
+        if (count[j] != 1) continue;
+        VertexType u = unique_neighbor[j];
+        std::fill(u_neighbor_colors.begin(), u_neighbor_colors.end(), false);
+        for (VertexType w : neighbors[u]) {
+            if (vertex_color[w] != -1) u_neighbor_colors[vertex_color[w]] = true;
+        }
+        for (int k = j + 1; k < num_colors; k++) {
+            if (not u_neighbor_colors[k]) {
+                vertex_color[max_saturated_vertex] = j;
+                vertex_color[u] = k;
+                swapped_vertex = u;
+                return true;//was able to swap colors
+            }
+        }
+    }
+    return false; //unable to swap two colors
+}
+
+
 Permutation Graph::max_degree_ordering() const {
     NeighborList neighbors = get_neighbor_list();
     return max_degree_ordering(neighbors);
@@ -927,6 +1069,7 @@ void Graph::remove_vertex(VertexType remove) {
     }
     _ncount--;
     removed_vertices.push_back(remove);
+    merged_into.push_back(UndefVertex);
     assert(removed_vertices.size() == removed_edges.size());
 }
 
@@ -991,6 +1134,7 @@ void Graph::remove_vertices_together(const std::vector<VertexType> &to_remove) {
     }
     _ncount -= static_cast<int>(to_remove.size());
     removed_vertices.insert(removed_vertices.end(), to_remove.rbegin(), to_remove.rend());
+    merged_into.resize(removed_vertices.size(), UndefVertex);
     assert(removed_vertices.size() == removed_edges.size());
 }
 
@@ -1054,53 +1198,445 @@ int Graph::remove_dominated_vertices(const NeighborList &neighbors) {
     return static_cast<int>(dominated_vertices.size());
 }
 
+int Graph::remove_twin_vertices() {
+    NeighborList neighbors = get_neighbor_list();
+    return remove_twin_vertices(neighbors);
+}
+
+int Graph::remove_twin_vertices(const NeighborList &neighbors) {
+    //twins have the same (sorted) neighbor list, so they are necessarily non-adjacent and dominate each other
+    //group them by their neighbor list and keep only the first vertex of each group
+    std::map< std::vector<VertexType>, VertexType > first_with_neighborhood;
+    std::vector<VertexType> twin_vertices;
+    for(VertexType v = 0; v < _ncount; v++){
+        auto inserted = first_with_neighborhood.insert({neighbors[v], v});
+        if(not inserted.second){
+            twin_vertices.push_back(v);
+        }
+    }
+    //vector is already sorted by construction
+    remove_vertices_together(twin_vertices);
+    return static_cast<int>(twin_vertices.size());
+}
+
+int Graph::remove_simplicial_vertices(int lower_bound, int &simplicial_clique_size) {
+    NeighborList neighbors = get_neighbor_list();
+    return remove_simplicial_vertices(lower_bound, simplicial_clique_size, neighbors);
+}
+
+int Graph::remove_simplicial_vertices(int lower_bound, int &simplicial_clique_size, const NeighborList &neighbors) {
+    std::vector<VertexType> simplicial_vertices;
+    simplicial_clique_size = 0;
+    std::vector<bool> in_neighborhood(_ncount, false);
+    for(VertexType v = 0; v < _ncount; v++){
+        for(VertexType nb : neighbors[v]){
+            in_neighborhood[nb] = true;
+        }
+        //neighborhood is a clique if every neighbor is adjacent to all other neighbors
+        bool is_simplicial = true;
+        for(VertexType nb : neighbors[v]){
+            auto num_adjacent = std::count_if(neighbors[nb].begin(), neighbors[nb].end(),
+                                              [&in_neighborhood](VertexType w){ return in_neighborhood[w]; });
+            if(static_cast<int>(num_adjacent) != static_cast<int>(neighbors[v].size()) - 1){
+                is_simplicial = false;
+                break;
+            }
+        }
+        for(VertexType nb : neighbors[v]){
+            in_neighborhood[nb] = false;
+        }
+        if(is_simplicial){
+            simplicial_vertices.push_back(v);
+            simplicial_clique_size = std::max(simplicial_clique_size, static_cast<int>(neighbors[v].size()) + 1);
+        }
+    }
+    //every simplicial vertex has degree smaller than max(lower_bound, simplicial_clique_size),
+    // so it can always be colored after the rest of the graph, the same argument as for peeling
+    assert(std::all_of(simplicial_vertices.begin(), simplicial_vertices.end(),
+        [&](VertexType v){ return static_cast<int>(neighbors[v].size()) < std::max(lower_bound, simplicial_clique_size); }));
+    //vector is already sorted by construction
+    remove_vertices_together(simplicial_vertices);
+    return static_cast<int>(simplicial_vertices.size());
+}
+
+int Graph::fuse_crown_vertices() {
+    NeighborList neighbors = get_neighbor_list();
+    return fuse_crown_vertices(neighbors);
+}
+
+int Graph::fuse_crown_vertices(const NeighborList &neighbors) {
+    //greedily grow a clique C from vertices with few non-neighbors, H are all non-neighbors of C
+    //a crown is found if every vertex in H can be matched to a non-adjacent vertex in C
+    std::vector<VertexType> candidates;
+    for(VertexType v = 0; v < _ncount; v++){
+        //universal vertices have no non-neighbors to fuse
+        if(static_cast<int>(neighbors[v].size()) < _ncount - 1){
+            candidates.push_back(v);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [&neighbors](VertexType v, VertexType w) { return neighbors[v].size() > neighbors[w].size(); });
+
+    std::vector<int> num_adjacent_in_clique(_ncount, 0);
+    std::vector<bool> in_crown_head(_ncount, false); //marks H
+    std::vector<VertexType> crown_head;
+    std::vector< std::vector<VertexType> > matchable_clique_vertices(_ncount); //non-adjacent vertices of C for h in H
+    std::vector<VertexType> matched_to(_ncount, UndefVertex); //for c in C, the vertex of H it is matched to
+    std::vector<VertexType> crown_matching(_ncount, UndefVertex); //for h in H, the vertex of C it is matched to
+    std::vector<VertexType> best_crown_head;
+    std::vector<VertexType> best_crown_matching;
+    int clique_size = 0;
+    std::vector<bool> is_neighbor(_ncount, false);
+    std::vector<bool> visited(_ncount, false);
+
+    //augmenting path search of kuhn's algorithm for the bipartite matching H to C
+    std::function<bool(VertexType)> try_augment = [&](VertexType h) -> bool {
+        for(VertexType c : matchable_clique_vertices[h]){
+            if(visited[c]){
+                continue;
+            }
+            visited[c] = true;
+            if(matched_to[c] == UndefVertex or try_augment(matched_to[c])){
+                matched_to[c] = h;
+                crown_matching[h] = c;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for(VertexType c : candidates){
+        if(num_adjacent_in_clique[c] != clique_size or in_crown_head[c]){
+            continue;
+        }
+        for(VertexType nb : neighbors[c]){
+            is_neighbor[nb] = true;
+        }
+        std::vector<VertexType> new_head;
+        for(VertexType h = 0; h < _ncount; h++){
+            if(h != c and not is_neighbor[h] and not in_crown_head[h]){
+                new_head.push_back(h);
+            }
+        }
+        //hall's condition can only hold if H is not larger than C, allow a single extra vertex while growing
+        if(static_cast<int>(crown_head.size() + new_head.size()) > clique_size + 1){
+            for(VertexType nb : neighbors[c]){
+                is_neighbor[nb] = false;
+            }
+            continue;
+        }
+        //add c to C and its non-neighbors to H
+        clique_size++;
+        for(VertexType nb : neighbors[c]){
+            num_adjacent_in_clique[nb]++;
+        }
+        for(VertexType h : new_head){
+            in_crown_head[h] = true;
+            crown_head.push_back(h);
+        }
+        for(VertexType h = 0; h < _ncount; h++){
+            if(in_crown_head[h] and not is_neighbor[h]){
+                matchable_clique_vertices[h].push_back(c);
+            }
+        }
+        for(VertexType nb : neighbors[c]){
+            is_neighbor[nb] = false;
+        }
+        //try to match all unmatched vertices of H
+        bool all_matched = true;
+        for(VertexType h : crown_head){
+            if(crown_matching[h] != UndefVertex){
+                continue;
+            }
+            std::fill(visited.begin(), visited.end(), false);
+            if(not try_augment(h)){
+                all_matched = false;
+            }
+        }
+        if(all_matched and not crown_head.empty()){
+            best_crown_head = crown_head;
+            best_crown_matching.clear();
+            for(VertexType h : crown_head){
+                best_crown_matching.push_back(crown_matching[h]);
+            }
+        }
+    }
+    if(best_crown_head.empty()){
+        return 0;
+    }
+    //fuse each vertex of H into its matched vertex of C, largest label first to keep the other labels intact
+    std::vector<std::pair<VertexType, VertexType>> fusions;
+    for(std::size_t i = 0; i < best_crown_head.size(); i++){
+        fusions.emplace_back(best_crown_head[i], best_crown_matching[i]);
+    }
+    std::sort(fusions.begin(), fusions.end(), std::greater<>());
+    for(std::size_t i = 0; i < fusions.size(); i++){
+        VertexType remove = fusions[i].first;
+        VertexType keep = fusions[i].second;
+        fuse_vertices(keep, remove);
+        //removing vertex 'remove' decreases all larger labels
+        for(std::size_t j = i + 1; j < fusions.size(); j++){
+            if(fusions[j].second > remove){
+                fusions[j].second--;
+            }
+        }
+    }
+    return static_cast<int>(fusions.size());
+}
+
+int Graph::fuse_clique_vertices(std::vector<VertexType> &clique) {
+    NeighborList neighbors = get_neighbor_list();
+    std::vector<bool> in_clique(_ncount, false);
+    for(VertexType q : clique){
+        in_clique[q] = true;
+    }
+    //for every u in C find one non-adjacent v outside of C that is adjacent to all of C\u
+    //fusing v into u only adds edges at u, so the conditions for the other pairs stay valid
+    std::vector<std::pair<VertexType, VertexType>> fusions;
+    std::vector<bool> already_fused(_ncount, false);
+    std::vector<int> num_adjacent_in_clique(_ncount, 0);
+    for(VertexType q : clique){
+        for(VertexType nb : neighbors[q]){
+            num_adjacent_in_clique[nb]++;
+        }
+    }
+    for(VertexType u : clique){
+        for(VertexType v = 0; v < _ncount; v++){
+            if(in_clique[v] or already_fused[v]
+                or std::binary_search(neighbors[u].begin(), neighbors[u].end(), v)){
+                continue;
+            }
+            if(num_adjacent_in_clique[v] == static_cast<int>(clique.size()) - 1){
+                fusions.emplace_back(v, u);
+                already_fused[v] = true;
+                break;
+            }
+        }
+    }
+    std::sort(fusions.begin(), fusions.end(), std::greater<>());
+    for(std::size_t i = 0; i < fusions.size(); i++){
+        VertexType remove = fusions[i].first;
+        VertexType keep = fusions[i].second;
+        fuse_vertices(keep, remove);
+        //removing vertex 'remove' decreases all larger labels, also for the clique
+        for(std::size_t j = i + 1; j < fusions.size(); j++){
+            if(fusions[j].second > remove){
+                fusions[j].second--;
+            }
+        }
+        for(VertexType &q : clique){
+            if(q > remove){
+                q--;
+            }
+        }
+    }
+    return static_cast<int>(fusions.size());
+}
+
+int Graph::add_clique_edges(const std::vector<VertexType> &clique) {
+    NeighborList neighbors = get_neighbor_list();
+    std::vector<bool> in_clique(_ncount, false);
+    for(VertexType q : clique){
+        in_clique[q] = true;
+    }
+    //store for every vertex outside of C the vertices of C it is not adjacent to
+    std::vector< std::vector<VertexType> > missing_clique_vertices(_ncount);
+    std::vector<bool> is_neighbor(_ncount, false);
+    for(VertexType v = 0; v < _ncount; v++){
+        if(in_clique[v]){
+            continue;
+        }
+        for(VertexType nb : neighbors[v]){
+            is_neighbor[nb] = true;
+        }
+        for(VertexType q : clique){
+            if(not is_neighbor[q]){
+                missing_clique_vertices[v].push_back(q);
+            }
+        }
+        for(VertexType nb : neighbors[v]){
+            is_neighbor[nb] = false;
+        }
+    }
+    //u,v can be joined by an edge if no vertex of C is missing in both neighborhoods
+    std::vector<VertexType> new_edges;
+    std::vector<bool> is_missing(_ncount, false);
+    for(VertexType u = 0; u < _ncount; u++){
+        //a vertex adjacent to all of C can't be colored at all, nothing to gain here
+        if(in_clique[u] or missing_clique_vertices[u].empty()){
+            continue;
+        }
+        for(VertexType q : missing_clique_vertices[u]){
+            is_missing[q] = true;
+        }
+        for(VertexType v = u + 1; v < _ncount; v++){
+            if(in_clique[v] or missing_clique_vertices[v].empty()
+                or std::binary_search(neighbors[u].begin(), neighbors[u].end(), v)){
+                continue;
+            }
+            bool disjoint = std::none_of(missing_clique_vertices[v].begin(), missing_clique_vertices[v].end(),
+                                         [&is_missing](VertexType q){ return is_missing[q]; });
+            if(disjoint){
+                new_edges.push_back(u);
+                new_edges.push_back(v);
+            }
+        }
+        for(VertexType q : missing_clique_vertices[u]){
+            is_missing[q] = false;
+        }
+    }
+    add_edges(new_edges);
+    return static_cast<int>(new_edges.size() / 2);
+}
+
+void Graph::fuse_vertices(VertexType keep, VertexType remove) {
+    assert(keep != remove);
+    //collect neighbors of both vertices, the edges of remove that keep doesn't have yet are added to keep
+    std::vector<bool> adjacent_to_keep(_ncount, false);
+    std::vector<VertexType> neighbors_of_remove;
+    for(VertexType i = 0; i < _ecount; i++){
+        VertexType v = _elist[2 * i], w = _elist[2 * i + 1];
+        if(v == keep or w == keep){
+            adjacent_to_keep[v == keep ? w : v] = true;
+        }
+        if(v == remove or w == remove){
+            neighbors_of_remove.push_back(v == remove ? w : v);
+        }
+    }
+    assert(not adjacent_to_keep[remove]);
+    std::vector<VertexType> new_edges;
+    for(VertexType w : neighbors_of_remove){
+        if(not adjacent_to_keep[w]){
+            new_edges.push_back(keep);
+            new_edges.push_back(w);
+        }
+    }
+    add_edges(new_edges);
+    remove_vertex(remove);
+    merged_into.back() = keep;
+}
+
+void Graph::add_edges(const std::vector<VertexType> &edge_list) {
+    if(edge_list.empty()){
+        return;
+    }
+    assert(edge_list.size() % 2 == 0);
+    if(remap.empty()){
+        //identity mapping, so that the graph counts as reduced
+        remap.resize(_ncount);
+        for (int v = 0; v < _ncount; ++v) {
+            remap[v] = v;
+        }
+    }
+    _elist.insert(_elist.end(), edge_list.begin(), edge_list.end());
+    _ecount += static_cast<int>(edge_list.size() / 2);
+    //edges are stored with the number of vertices removed so far, they are deleted once recovery gets back to that point
+    added_edges.emplace_back(removed_vertices.size(), edge_list);
+}
+
 std::vector<VertexType> Graph::get_remapping() const {
     return remap;
 }
 
 std::vector<VertexType> Graph::recover_reductions() {
-    assert(not removed_vertices.empty());
-    assert(not removed_edges.empty());
+    std::vector<VertexType> fused_with;
+    return recover_reductions(fused_with);
+}
+
+std::vector<VertexType> Graph::recover_reductions(std::vector<VertexType> &fused_with) {
+    std::vector<std::vector<VertexType>> removal_neighbors;
+    return recover_reductions(fused_with, removal_neighbors);
+}
+
+std::vector<VertexType> Graph::recover_reductions(std::vector<VertexType> &fused_with,
+                                                  std::vector<std::vector<VertexType>> &removal_neighbors) {
+    assert(not removed_vertices.empty() or not added_edges.empty());
     assert(removed_vertices.size() == removed_edges.size());
+    assert(removed_vertices.size() == merged_into.size());
     assert(not remap.empty());
 
     //store vertices that were recovered, update them correctly to be of the right vertex labeling
     std::vector<VertexType> recovered_vertices;
+    fused_with.clear();
+    removal_neighbors.clear();
+
+    //deletes the edges that were added when the given number of vertices had been removed
+    auto delete_added_edges = [this](std::size_t num_removed) {
+        while(not added_edges.empty() and added_edges.back().first == num_removed) {
+            const std::vector<VertexType> &edges = added_edges.back().second;
+            for(std::size_t i = 0; i < edges.size(); i += 2) {
+                for(int edge_index = _ecount - 1; edge_index >= 0; edge_index--) {
+                    if((_elist[2 * edge_index] == edges[i] and _elist[2 * edge_index + 1] == edges[i + 1])
+                        or (_elist[2 * edge_index] == edges[i + 1] and _elist[2 * edge_index + 1] == edges[i])) {
+                        _elist.erase(std::next(_elist.begin(), 2 * edge_index + 1));
+                        _elist.erase(std::next(_elist.begin(), 2 * edge_index));
+                        _ecount--;
+                        break;
+                    }
+                }
+            }
+            added_edges.pop_back();
+        }
+    };
+    delete_added_edges(removed_vertices.size());
 
     //to insert vertices again, start with last one removed, update vertex mapping
     // and thus edges, then insert removed edges
-    //extra iterator to iterate over vectors of removed edges
-    auto re_vec = removed_edges.rbegin();
-    for (auto rv = removed_vertices.rbegin(); rv != removed_vertices.rend(); ++rv, ++re_vec) {
+    for (std::size_t index = removed_vertices.size(); index-- > 0; ) {
+        VertexType rv = removed_vertices[index];
+        const std::vector<VertexType> &re_vec = removed_edges[index];
         //relabel edges to before vertex was removed
         for(int edge_index = _ecount - 1; edge_index >= 0; edge_index--) {
-            if (_elist[2 * edge_index + 1] >= *rv) {
+            if (_elist[2 * edge_index + 1] >= rv) {
                 _elist[2 * edge_index + 1]++;
             }
-            if (_elist[2 * edge_index] >= *rv) {
+            if (_elist[2 * edge_index] >= rv) {
                 _elist[2 * edge_index]++;
             }
         }
         //insert edges that were removed with removal of that vertex
-        for (auto re = (*re_vec).rbegin(); re != (*re_vec).rend(); ++re){
+        for (auto re = re_vec.rbegin(); re != re_vec.rend(); ++re){
             _elist.push_back(*re);
         }
-        _ecount += (static_cast<int>((*re_vec).size()) / 2);
+        _ecount += (static_cast<int>(re_vec.size()) / 2);
         assert(_ecount == static_cast<int>(_elist.size()/2));
 
-        //update vector of recovered vertices
+        //update vector of recovered vertices and the vertices they were fused into
         for (VertexType &recovered : recovered_vertices) {
-            if(recovered >= *rv){
+            if(recovered >= rv){
                 recovered++;
             }
         }
-        recovered_vertices.push_back(*rv);
+        for (VertexType &partner : fused_with) {
+            if(partner != UndefVertex and partner >= rv){
+                partner++;
+            }
+        }
+        for (std::vector<VertexType> &neighbors : removal_neighbors) {
+            for (VertexType &neighbor : neighbors) {
+                if(neighbor >= rv){
+                    neighbor++;
+                }
+            }
+        }
+        recovered_vertices.push_back(rv);
+        fused_with.push_back(merged_into[index]);
+        //the removed edges are in the labels before the removal, which are the current ones
+        removal_neighbors.emplace_back();
+        for (std::size_t i = 0; i < re_vec.size(); i += 2) {
+            removal_neighbors.back().push_back(re_vec[i] == rv ? re_vec[i + 1] : re_vec[i]);
+        }
+
+        //labels are now as they were before this vertex was removed, undo edges added at that point
+        delete_added_edges(index);
     }
+    assert(added_edges.empty());
     _ncount += static_cast<int>(removed_vertices.size());
     assert(_ncount == static_cast<int>(remap.size()));
 
     removed_vertices.clear();
     removed_edges.clear();
+    merged_into.clear();
     remap.clear();
     return recovered_vertices;
 }
@@ -21,6 +21,9 @@
 #include <cmath>
 #include <random>
 #include <cassert>
+#include <map>
+#include <utility>
+#include <functional>
 
 namespace Graph{
 
@@ -28,10 +31,31 @@ using VertexType = int;
 const VertexType UndefVertex = std::numeric_limits<VertexType>::max();
 //type to store for a vertex j the set of neighboring vertices as neighbors[j]
 using NeighborList = std::vector< std::vector<VertexType> >;
+//the same in one flat array with the offset of each vertex, for large lists like the complement of a sparse graph
+struct CompactNeighborList {
+    struct Neighbors {
+        const VertexType *first;
+        const VertexType *last;
+        [[nodiscard]] const VertexType *begin() const { return first; }
+        [[nodiscard]] const VertexType *end() const { return last; }
+        [[nodiscard]] std::size_t size() const { return last - first; }
+        [[nodiscard]] bool empty() const { return first == last; }
+    };
+    std::vector<long long> offsets; //num vertices + 1 entries
+    std::vector<VertexType> neighbors;
+
+    Neighbors operator[](VertexType v) const {
+        return {neighbors.data() + offsets[v], neighbors.data() + offsets[v + 1]};
+    }
+    [[nodiscard]] std::size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+};
 //note that permutations are given as positive integers, there is no i s.t. perm[i] = 0, it's always positive
 using Permutation = std::vector<int>;
 using ColorClass = std::set<VertexType>;
 using Coloring = std::vector<ColorClass>;
+//flat coloring, maps each vertex to its color starting at color 0
+using ColorMap = std::vector<int>;
 
 
 
@@ -77,6 +101,7 @@ public:
      * ncount, ecount, elist : return the corresponding data field of the class
      * complement_elist : a helper function to get all the edges of the complement graph
      * get_complement : returns a graph with the same number of vertices but the edges of the complement graph
+     * get_complement_neighbor_list : the compact neighbor list of the complement, without building its edge list
      * perm_graph : returns the permuted graph for a given permutation
      * use_random_tiebreaks : enables the use of randomness during choices in the coloring heuristics and orderings
      * print : outputs the graph in an adjacency list format
@@ -98,6 +123,7 @@ public:
 
     [[nodiscard]] std::vector<VertexType> complement_elist() const;
     [[nodiscard]] Graph get_complement() const;
+    [[nodiscard]] CompactNeighborList get_complement_neighbor_list() const;
 
     [[nodiscard]] Graph perm_graph(const Permutation &perm) const;
 
@@ -115,6 +141,10 @@ private:
     std::vector<VertexType> removed_vertices;
     std::vector< std::vector<VertexType> > removed_edges;
     std::vector<VertexType> remap;
+    //for each removed vertex the vertex it was fused into (label before the removal), UndefVertex if simply removed
+    std::vector<VertexType> merged_into;
+    //edges added by reductions together with the number of removed vertices at that time, undone in recovery
+    std::vector< std::pair<std::size_t, std::vector<VertexType>> > added_edges;
 
     //helper functions to build the graph, either reading in dimacs or .g6 format
     void read_dimacs(const char *filename);
@@ -143,6 +173,12 @@ public:
      * Additionally, a clique can be passed to each algorithm whose vertices colors will be fixed. This can lead
      * to fewer mistakes in the heuristic since we already know these vertices will have to be colored distinctly.
      *
+     * dsatur_color_map : same vertex choices and recoloring as dsatur, but keeps the uncolored vertices in a heap
+     *                   ordered by saturation and degree and the colors in the neighborhood of a vertex as a bitset,
+     *                   so it avoids the linear scan per step. Returns the color of each vertex instead of the
+     *                   color classes, dsatur is computed with it
+     * to_coloring : collects the color classes of a flat coloring
+     *
      * try_color_swap : implements the recolor technique for the coloring heuristics used.
      *                  if a new color class would be created, check if we can swap the colors of two vertices
      *                  to avoid having to use a new color class. This generally improves the heuristics
@@ -155,6 +191,11 @@ public:
     Coloring dsatur(Permutation &ordering, const std::vector<VertexType> &clique = {}) const;
     Coloring dsatur(Permutation &ordering, const NeighborList &neighbors, const std::vector<VertexType> &clique = {}) const;
 
+    ColorMap dsatur_color_map(Permutation &ordering, const std::vector<VertexType> &clique = {}) const;
+    ColorMap dsatur_color_map(Permutation &ordering, const NeighborList &neighbors,
+                              const std::vector<VertexType> &clique = {}) const;
+    static Coloring to_coloring(const ColorMap &color_map);
+
     Coloring dsatur_original(Permutation &ordering, const std::vector<VertexType> &clique = {}) const;
     Coloring
     dsatur_original(Permutation &ordering, const NeighborList &neighbors, const std::vector<VertexType> &clique = {}) const;
@@ -172,6 +213,8 @@ public:
 
     static bool try_color_swap(VertexType max_saturated_vertex, const NeighborList &neighbors, Coloring &coloring,
                                std::vector<int> &vertex_color);
+    static bool try_color_swap(VertexType max_saturated_vertex, const NeighborList &neighbors, ColorMap &vertex_color,
+                               int num_colors, VertexType &swapped_vertex);
 
     //this is never used and not useful as a vertex ordering for this problem
     [[nodiscard]] Permutation max_degree_ordering() const;
@@ -190,6 +233,20 @@ public:
      * peel_graph : removes all vertices with degree strictly smaller than the specified number
      * remove_dominated_vertices : removes all dominated vertices from the graph. A vertex is dominated by another
      *                             vertex if all his neighbors are also adjacent to that other vertex
+     * remove_twin_vertices : removes all but one vertex of each class of vertices with identical neighborhoods,
+     *                        found by sorting the neighbor lists instead of the pairwise domination test
+     * remove_simplicial_vertices : removes all vertices whose neighborhood is a clique. The largest such closed
+     *                              neighborhood is a clique and returned in simplicial_clique_size, every
+     *                              simplicial vertex has fewer neighbors than that and can be colored last
+     * fuse_crown_vertices : looks for a crown in the complement graph, i.e., a clique C s.t. the non-neighbors H
+     *                       of C can be matched into C by non-edges. Then chi(G) = chi(G - C - H) + |C| and there
+     *                       is an optimal coloring where h has the color of its matched vertex, so h is fused into it
+     * fuse_clique_vertices : for a clique C and u in C, fuses a non-adjacent v into u if v is adjacent to C\u
+     * add_clique_edges : for a clique C, adds the edge u,v if every vertex of C is adjacent to u or v
+     *                    the last two rules are only valid when coloring with exactly |C| colors
+     *
+     * fuse_vertices : merges two non-adjacent vertices by giving keep all neighbors of remove, then removes it
+     * add_edges : adds the given edges to the graph, they are removed again when recovering the reductions
      */
 
     void remove_vertex(VertexType remove);
@@ -204,12 +261,35 @@ public:
     int remove_dominated_vertices();
     int remove_dominated_vertices(const NeighborList &neighbors);
 
+    int remove_twin_vertices();
+    int remove_twin_vertices(const NeighborList &neighbors);
+
+    int remove_simplicial_vertices(int lower_bound, int &simplicial_clique_size);
+    int remove_simplicial_vertices(int lower_bound, int &simplicial_clique_size, const NeighborList &neighbors);
+
+    int fuse_crown_vertices();
+    int fuse_crown_vertices(const NeighborList &neighbors);
+
+    int fuse_clique_vertices(std::vector<VertexType> &clique);
+    int add_clique_edges(const std::vector<VertexType> &clique);
+
+    void fuse_vertices(VertexType keep, VertexType remove);
+    void add_edges(const std::vector<VertexType> &edge_list);
+
 
     [[nodiscard]] std::vector<VertexType> get_remapping() const;
 
     //recovers the reductions done on the graph by peeling and removing dominating vertices
     //Careful: only works if graph is in original ordering, i.e. no permutation was done/permutations were reverted
     std::vector<VertexType> recover_reductions();
+    //same, but also returns for each recovered vertex the vertex it was fused into or UndefVertex,
+    // such a vertex has to receive the color of that vertex
+    std::vector<VertexType> recover_reductions(std::vector<VertexType> &fused_with);
+    //same, but also returns the neighbors each recovered vertex had when it was removed, including edges that were
+    // inherited from fused vertices or added. coloring the vertices in the returned order against these neighbors
+    // undoes the reductions one at a time
+    std::vector<VertexType> recover_reductions(std::vector<VertexType> &fused_with,
+                                               std::vector<std::vector<VertexType>> &removal_neighbors);
 
 
     /*
@@ -8,6 +8,7 @@ MGraph::MGraph(const int n, const int m, const std::vector<int> &edge_list) {
     gmatrix = std::vector<Bitset>(size, Bitset(size));
     nodeset = Bitset(size);
     nodeset.set();
+    changed_vertices = Bitset(size);
     //initialise list of vertices to all vertices
     vertices = std::vector<int>(size);
     std::iota(vertices.begin(), vertices.end(), 0);
@@ -43,6 +44,8 @@ void MGraph::add_edge(const int u, const int v) {
     assert(not has_edge(u,v));
     gmatrix[u].set(v);
     gmatrix[v].set(u);
+    changed_vertices.set(u);
+    changed_vertices.set(v);
     if (current_level > 0) {
         added_edges_trail.insert(added_edges_trail.end(), {u,v});
     }
@@ -52,6 +55,8 @@ void MGraph::remove_edge(const int u, const int v) {
     assert(has_edge(u,v));
     gmatrix[u].reset(v);
     gmatrix[v].reset(u);
+    changed_vertices.set(u);
+    changed_vertices.set(v);
 }
 
 bool MGraph::is_contracted(const int u, const int v) const {
@@ -94,6 +99,7 @@ void MGraph::contract_vertices(int u, int v) {
     std::copy(bag[v].begin(), bag[v].end(), std::back_inserter(bag[u]));
 
     nodeset.reset(v); //vertex contracted, not available anymore
+    changed_vertices.set(v);
     removed_vertices.push_back(v);
     num_vertices--;
     //contracted v into u, remove v from list of vertices
@@ -181,6 +187,7 @@ void MGraph::notify_backtrack_level(const int new_level) {
             break;
         }
         nodeset.set(v);
+        changed_vertices.set(v);
         removed_vertices.pop_back();
         num_vertices++;
         vertices.push_back(v); //restored vertex, add it back to list
@@ -305,104 +312,146 @@ void MGraph::print() {
     }
 }
 
-int MGraph::dsatur_coloring(const Bitset &clique) const {
-    std::vector<std::set<int>> coloring;
-    Bitset available_vertices = nodeset & ~clique;
-    std::vector<int> uncolored_vertices;
-    for (int v = available_vertices.find_first(); v != Bitset::npos; v = available_vertices.find_next(v)) {
-        uncolored_vertices.push_back(v);
-    }
-    int colors = uncolored_vertices.size() + clique.count();
-    //initialise all vertices to be uncolored and have zero saturation
-    std::vector<int> vertex_color(size, -1);
-    std::vector<Bitset> forbidden_colors(colors, Bitset(size)); //colors rows and vertices columns!
-    //record for an uncolored vertex to how many colored vertices it is connected to
-    std::vector<int> saturation_level(size, 0);
-
-    int nclique_colors = 0;
-    if(clique.count() > 2){//ignore trivial or empty clique
-        //fix color of the vertices of supplied clique and set saturation levels
-        int color = 0;
-        for(auto vertex = clique.find_first(); vertex != Bitset::npos; vertex = clique.find_next(vertex)){
-            coloring.emplace_back(); //new color class
-            coloring[color].insert(vertex); //assign first color to max degree vertex
-            vertex_color[vertex] = color;
-            forbidden_colors[color] |= gmatrix[vertex];
-            color++;
-            //update saturation levels
-            for(auto neighbor = gmatrix[vertex].find_first(); neighbor != Bitset::npos; neighbor = gmatrix[vertex].find_next(neighbor)){
-                saturation_level[neighbor]++;
+int MGraph::dsatur_coloring(const Bitset &clique, std::vector<int> &vertex_color) const {
+    //uncolored vertices are kept in buckets by saturation level and the colors forbidden for a vertex are stored
+    //as 64 bit words, so coloring a vertex only touches its uncolored neighbors. each bucket is a binary heap ordered
+    //by degree, so the next vertex and the moves between buckets take logarithmic time
+    ScratchArena::Frame frame(scratch);
+    Bitset &uncolored = frame.bitset(size);
+    uncolored = nodeset;
+    std::vector<int> &degree = frame.ints(size, 0);
+    Bitset &neighbors = frame.bitset(size);
+    int max_degree = 0;
+    for (std::size_t v = nodeset.find_first(); v != Bitset::npos; v = nodeset.find_next(v)) {
+        neighbors = gmatrix[v];
+        neighbors &= nodeset;
+        degree[v] = static_cast<int>(neighbors.count());
+        max_degree = std::max(max_degree, degree[v]);
+    }
+    //dsatur never needs more than max_degree + 1 colors, the clique colors are among those
+    const int words = (max_degree + 1) / 64 + 1;
+    std::vector<std::uint64_t> &forbidden = frame.words(static_cast<std::size_t>(size) * words);
+    std::vector<int> &saturation_level = frame.ints(size, 0);
+    std::vector<std::vector<int>> &buckets = frame.int_lists(max_degree + 2);
+    std::vector<int> &bucket_position = frame.ints(size, -1);
+    int max_bucket = 0;
+    int num_colors = 0;
+    vertex_color.assign(size, -1);
+
+    //ties in saturation are broken by the largest degree, then the smallest label
+    auto before = [&](int v, int w) { return degree[v] > degree[w] or (degree[v] == degree[w] and v < w); };
+    auto place = [&](std::vector<int> &bucket, int position, int v) {
+        bucket[position] = v;
+        bucket_position[v] = position;
+    };
+    auto sift_up = [&](std::vector<int> &bucket, int position) {
+        int v = bucket[position];
+        while (position > 0 and before(v, bucket[(position - 1) / 2])) {
+            place(bucket, position, bucket[(position - 1) / 2]);
+            position = (position - 1) / 2;
+        }
+        place(bucket, position, v);
+    };
+    auto sift_down = [&](std::vector<int> &bucket, int position) {
+        int v = bucket[position];
+        const int bucket_size = static_cast<int>(bucket.size());
+        while (2 * position + 1 < bucket_size) {
+            int child = 2 * position + 1;
+            if (child + 1 < bucket_size and before(bucket[child + 1], bucket[child])) {
+                child++;
             }
-            nclique_colors++;
-        }
-    }
-    //iterate while there are uncolored vertices
-    while (not uncolored_vertices.empty()) {
-        int max_saturated_vertex = 0;
-        int max_saturated = -1;
-        //find vertex with largest saturation degree
-        for(int vertex : uncolored_vertices){
-            //iterate over only uncolored vertices
-            assert(vertex_color[vertex] == -1);
-            if(saturation_level[vertex] > max_saturated){
-                //found vertex with higher saturation, update
-                max_saturated = saturation_level[vertex];
-                max_saturated_vertex = vertex;
-            } else if(saturation_level[vertex] == max_saturated and gmatrix[vertex].count() > gmatrix[max_saturated_vertex].count()){
-                    //found vertex with equal saturation but higher degree, update
-                    max_saturated_vertex = vertex;
+            if (not before(bucket[child], v)) {
+                break;
             }
-        }
-        //find lowest color for vertex
-        int lowest_color = -1;
-        for(int color = 0; color < colors; color++) {
-            if(forbidden_colors[color][max_saturated_vertex]) {
-                continue; //color not available
+            place(bucket, position, bucket[child]);
+            position = child;
+        }
+        place(bucket, position, v);
+    };
+    auto push = [&](int level, int v) {
+        buckets[level].push_back(v);
+        sift_up(buckets[level], static_cast<int>(buckets[level].size()) - 1);
+        max_bucket = std::max(max_bucket, level);
+    };
+    auto remove = [&](int level, int v) {
+        std::vector<int> &bucket = buckets[level];
+        int position = bucket_position[v];
+        int last = bucket.back();
+        bucket.pop_back();
+        bucket_position[v] = -1;
+        if (last != v) {
+            place(bucket, position, last);
+            sift_up(bucket, position);
+            sift_down(bucket, bucket_position[last]);
+        }
+    };
+
+    //color vertex and forbid its color for the uncolored neighbors, moving them up one bucket if the color is new
+    auto assign_color = [&](int vertex, int color) {
+        uncolored.reset(vertex);
+        vertex_color[vertex] = color;
+        num_colors = std::max(num_colors, color + 1);
+        const std::size_t word = color / 64;
+        const std::uint64_t bit = std::uint64_t{1} << (color % 64);
+        const Bitset &adjacent = gmatrix[vertex];
+        for (std::size_t neighbor = adjacent.find_first(); neighbor != Bitset::npos; neighbor = adjacent.find_next(neighbor)) {
+            if (not uncolored[neighbor]) continue;
+            const int w = static_cast<int>(neighbor);
+            std::uint64_t &forbidden_word = forbidden[static_cast<std::size_t>(w) * words + word];
+            if (forbidden_word & bit) continue;
+            forbidden_word |= bit;
+            if (bucket_position[w] != -1) {
+                remove(saturation_level[w], w);
+                push(saturation_level[w] + 1, w);
             }
-            lowest_color = color;
-            break;
+            saturation_level[w]++;
         }
-        assert(lowest_color != -1);
-        //assign color and update forbidden colors
-        uncolored_vertices.erase(std::find(uncolored_vertices.begin(), uncolored_vertices.end(), max_saturated_vertex));
-        available_vertices.reset(max_saturated_vertex);
-        if(lowest_color >= coloring.size()) {
-            assert(lowest_color == coloring.size());
-            coloring.emplace_back(); //new color class
-        }
-        //assign first color to max saturated vertex
-        coloring[lowest_color].insert(max_saturated_vertex);
-        vertex_color[max_saturated_vertex] = lowest_color;
-        forbidden_colors[lowest_color] |= gmatrix[max_saturated_vertex];
-
-        //new vertex has been selected so update the saturation levels of all its neighbors if it's a different color
-        //only iterate over neighbours that are still available
-        Bitset neighbour_set = gmatrix[max_saturated_vertex] & available_vertices;
-        for (auto vertex = neighbour_set.find_first(); vertex != Bitset::npos; vertex = neighbour_set.find_next(vertex)) {
-            bool is_new_color = true;
-            for (auto adj_vertex = gmatrix[vertex].find_first(); adj_vertex != Bitset::npos; adj_vertex = gmatrix[vertex].find_next(adj_vertex)) {
-                if(adj_vertex != max_saturated_vertex and vertex_color[adj_vertex] == lowest_color){
-                    //found neighbor of neighbor that uses msv color, so we don't increase the saturation level
-                    is_new_color = false;
-                    break;
-                }
-            }
-            if(is_new_color) {
-                saturation_level[vertex]++;
+    };
+
+    //fix color of the vertices of supplied clique
+    int color = 0;
+    for (auto vertex = clique.find_first(); vertex != Bitset::npos; vertex = clique.find_next(vertex)) {
+        assert(nodeset[vertex]);
+        assign_color(static_cast<int>(vertex), color++);
+    }
+    for (std::size_t v = uncolored.find_first(); v != Bitset::npos; v = uncolored.find_next(v)) {
+        push(saturation_level[v], static_cast<int>(v));
+    }
+
+    while (true) {
+        while (max_bucket > 0 and buckets[max_bucket].empty()) {
+            max_bucket--;
+        }
+        if (buckets[max_bucket].empty()) {
+            break; //all vertices colored
+        }
+        int max_saturated_vertex = buckets[max_bucket].front();
+        remove(max_bucket, max_saturated_vertex);
+
+        //lowest color is the first zero bit among the forbidden colors
+        int lowest_color = 0;
+        const std::uint64_t *vertex_forbidden = &forbidden[static_cast<std::size_t>(max_saturated_vertex) * words];
+        for (int word = 0; word < words; ++word) {
+            if (~vertex_forbidden[word] != 0) {
+                lowest_color = word * 64 + __builtin_ctzll(~vertex_forbidden[word]);
+                break;
             }
         }
+        assert(lowest_color <= max_degree);
+        assign_color(max_saturated_vertex, lowest_color);
     }
 
     //colored all vertices
-    return coloring.size();
+    return num_colors;
 }
 
 
-int MGraph::sequential_coloring(const Bitset &clique) const {
-    std::vector<std::set<int>> coloring;
-    std::vector<int> available_vertices;
-    available_vertices.reserve(nodeset.count());
-    Bitset nodes_minus_clique = (nodeset & ~clique);
+int MGraph::sequential_coloring(const Bitset &clique, std::vector<int> &vertex_color) const {
+    ScratchArena::Frame frame(scratch);
+    std::vector<int> &available_vertices = frame.ints();
+    Bitset &nodes_minus_clique = frame.bitset(size);
+    nodes_minus_clique = nodeset;
+    nodes_minus_clique -= clique;
     assert(nodes_minus_clique.count() == (nodeset.count() - clique.count()));
     for(int vertex = nodes_minus_clique.find_first(); vertex != Bitset::npos; vertex = nodes_minus_clique.find_next(vertex)) {
         available_vertices.push_back(vertex);
@@ -411,69 +460,58 @@ int MGraph::sequential_coloring(const Bitset &clique) const {
     std::sort(available_vertices.begin(), available_vertices.end(),
         [&](int v, int w){return bag[v].size() > bag[w].size() or (bag[v].size() == bag[w].size() and gmatrix[v].count() > gmatrix[w].count());});
 
-    int colors = available_vertices.size() + clique.count();
-    //initialise all vertices to be uncolored and have zero saturation
-    std::vector<int> vertex_color(size, -1);
-    std::vector<Bitset> forbidden_colors(colors, Bitset(size)); //colors rows and vertices columns!
+    //initialise all vertices to be uncolored
+    vertex_color.assign(size, -1);
+    //one row per used color with the vertices that can't get that color
+    BitsetList &forbidden_colors = frame.bitset_list(size);
 
-    int nclique_colors = 0;
-    if(clique.count() > 2){//ignore trivial or empty clique
-        //fix color of the vertices of supplied clique and set saturation levels
-        int color = 0;
-        for(auto vertex = clique.find_first(); vertex != Bitset::npos; vertex = clique.find_next(vertex)){
-            coloring.emplace_back(); //new color class
-            coloring[color].insert(vertex); //assign first color to max degree vertex
-            vertex_color[vertex] = color;
-            forbidden_colors[color] |= gmatrix[vertex];
-            color++;
-            nclique_colors++;
-        }
+    //fix color of the vertices of supplied clique, they are not among the available vertices
+    int color = 0;
+    for(auto vertex = clique.find_first(); vertex != Bitset::npos; vertex = clique.find_next(vertex)){
+        forbidden_colors.emplace_back() |= gmatrix[vertex]; //new color class
+        vertex_color[vertex] = color;
+        color++;
     }
 
     //iterate over all uncolored vertices
     for(int vertex : available_vertices){
         assert(vertex_color[vertex] == -1);
-        //find lowest color for vertex
-        int lowest_color = -1;
-        for(int color = 0; color < colors; color++) {
+        //find lowest color for vertex, or open a new one
+        int lowest_color = static_cast<int>(forbidden_colors.size());
+        for(int color = 0; color < static_cast<int>(forbidden_colors.size()); color++) {
             if(forbidden_colors[color][vertex]) {
                 continue; //color not available
             }
             lowest_color = color;
             break;
         }
-        assert(lowest_color != -1);
         //assign color and update forbidden colors
-        if(lowest_color >= coloring.size()) {
-            assert(lowest_color == coloring.size());
-            coloring.emplace_back(); //new color class
+        if(lowest_color == static_cast<int>(forbidden_colors.size())) {
+            forbidden_colors.emplace_back(); //new color class
         }
-        coloring[lowest_color].insert(vertex); //assign first color to max degree vertex
         vertex_color[vertex] = lowest_color;
         forbidden_colors[lowest_color] |= gmatrix[vertex];
     }
     //colored all vertices
-    return coloring.size();
+    return static_cast<int>(forbidden_colors.size());
 }
 
-int MGraph::IS_extract(const Bitset &clique) const {
+int MGraph::IS_extract(const Bitset &clique, std::vector<int> &vertex_color) const {
     //try to build a good coloring by building large independent sets
     //iterate over vertices and try to add it to first independent set that admits it, or create a new one if we have to
     //kind of the complement of the greedy clique search
-    std::vector<Bitset> independent_sets;
+    ScratchArena::Frame frame(scratch);
+    BitsetList &independent_sets = frame.bitset_list(size);
 
-    std::vector<int> order = vertices; //generate lexikographic order on remaining vertices, later other heuristic
+    const std::vector<int> &order = vertices; //lexikographic order on remaining vertices, later other heuristic
     assert(not order.empty());
     //sort in order of decreasing bag size
     // std::sort(order.begin(), order.end(), [&](int v, int w){return bag[v].size() > bag[w].size();});
     // std::sort(order.begin(), order.end(), [&](int v, int w){return gmatrix[v].count() > gmatrix[w].count();});
 
-    //create singleton independent sets for the clique vertices
-    if(clique.count() > 2){//ignore trivial or empty clique
-        for(auto vertex = clique.find_first(); vertex != Bitset::npos; vertex = clique.find_next(vertex)){
-            independent_sets.emplace_back(size);
-            independent_sets.back().set(vertex);
-        }
+    //create singleton independent sets for the clique vertices, they are skipped below
+    for(auto vertex = clique.find_first(); vertex != Bitset::npos; vertex = clique.find_next(vertex)){
+        independent_sets.emplace_back().set(vertex);
     }
 
     //iterate over vertices and add to independent set if possible
@@ -484,7 +522,7 @@ int MGraph::IS_extract(const Bitset &clique) const {
         bool inserted = false;
         for(auto & indset : independent_sets){
             //check whether vertex is adjacent to none of the vertices, i.e. N(v) intersect indset == empty
-            if((gmatrix[v] & indset).none()) {
+            if(not gmatrix[v].intersects(indset)) {
                 indset.set(v);
                 inserted = true;
                 break;
@@ -494,22 +532,25 @@ int MGraph::IS_extract(const Bitset &clique) const {
         if(not inserted) {
             bool recolored = try_recolor(v, independent_sets);
             if(not recolored) {
-                independent_sets.emplace_back(size);
-                independent_sets.back().set(v);
+                independent_sets.emplace_back().set(v);
             }
         }
     }
     //no code to insert vertices into previous sets necessary here
-    return independent_sets.size();
+    color_classes_to_vertex_colors(independent_sets, vertex_color);
+    return static_cast<int>(independent_sets.size());
 }
 
-int MGraph::ISEQ() const {
+int MGraph::ISEQ(std::vector<int> &vertex_color) const {
+    ScratchArena::Frame frame(scratch);
     int color_index = 0;
-    std::vector<Bitset> coloring; //store colorclasses as bitsets for now, convert them later
-    Bitset nodes = nodeset; //copy available vertices
-    Bitset tmp_nodes = nodes; //util set
+    BitsetList &coloring = frame.bitset_list(size); //store colorclasses as bitsets for now, convert them later
+    Bitset &nodes = frame.bitset(size);
+    nodes = nodeset; //copy available vertices
+    Bitset &tmp_nodes = frame.bitset(size); //util set
+    tmp_nodes = nodes;
     while (nodes.any()) { //while there are still uncolored vertices
-        coloring.emplace_back(size);
+        coloring.emplace_back();
         assert(color_index + 1 == coloring.size());
         while (tmp_nodes.any()) {
             int v = tmp_nodes.find_first();
@@ -521,7 +562,7 @@ int MGraph::ISEQ() const {
             tmp_nodes.reset(v);
             if(not recolored) {
                 coloring[color_index].set(v); //assign color
-                tmp_nodes &= ~gmatrix[v]; //remove adjacent vertices
+                tmp_nodes -= gmatrix[v]; //remove adjacent vertices
             }
             nodes.reset(v);
         }
@@ -530,18 +571,35 @@ int MGraph::ISEQ() const {
         color_index++;
     }
     //nodes is empty, every vertex is colored and coloring.size() colors were used
-    return coloring.size();
+    color_classes_to_vertex_colors(coloring, vertex_color);
+    return static_cast<int>(coloring.size());
 }
 
-bool MGraph::try_recolor(const int vertex, std::vector<Bitset> &coloring) const {
+void MGraph::color_classes_to_vertex_colors(const BitsetList &color_classes, std::vector<int> &vertex_color) const {
+    vertex_color.assign(size, -1);
+    for (int color = 0; color < static_cast<int>(color_classes.size()); ++color) {
+        const Bitset &color_class = color_classes[color];
+        for (int v = color_class.find_first(); v != Bitset::npos; v = color_class.find_next(v)) {
+            vertex_color[v] = color;
+        }
+    }
+}
+
+bool MGraph::try_recolor(const int vertex, BitsetList &coloring) const {
+    ScratchArena::Frame frame(scratch);
+    Bitset &ck_intersect_nv = frame.bitset(size);
+    if (coloring.size() < 2) {
+        return false; //no two classes to swap between
+    }
     //last class of coloring is the new colorclass for vertex
     for (auto k1 = coloring.begin(); k1 != coloring.end() - 2; ++k1) {
-        auto ck_intersect_nv = *k1 & gmatrix[vertex];
+        ck_intersect_nv = *k1;
+        ck_intersect_nv &= gmatrix[vertex];
         int w = ck_intersect_nv.find_first();
         //check that w is Only element of intersection
         if(w != Bitset::npos and ck_intersect_nv.find_next(w) == Bitset::npos) {
             for (auto k2 = std::next(k1); k2 != coloring.end() - 1; ++k2) {
-                if((*k2 & gmatrix[w]).none()) {
+                if(not k2->intersects(gmatrix[w])) {
                     k1->reset(w);
                     k1->set(vertex);
                     k2->set(w);
@@ -564,9 +622,10 @@ int MGraph::greedy_cliques(std::vector<Bitset> &clique_list, const int clique_li
     //we maintain a list of cliques and iterate through vertices in given ordering
     //try to add vertex to all cliques in list or create new one if it can't be added
 
-    std::vector<Bitset> cliques;
-    std::vector<int> clique_sz; //to keep track of sizes instead of needing to call Bitset.count() which can be linear
-    std::vector<int> last_inserted_index(size); //track the last clique where this vertex was added
+    ScratchArena::Frame frame(scratch);
+    BitsetList &cliques = frame.bitset_list(size);
+    std::vector<int> &clique_sz = frame.ints(); //to keep track of sizes instead of needing to call Bitset.count() which can be linear
+    std::vector<int> &last_inserted_index = frame.ints(size, 0); //track the last clique where this vertex was added
 
     assert(not vertices.empty());
     // std::vector<int> order = vertices;
@@ -581,7 +640,7 @@ int MGraph::greedy_cliques(std::vector<Bitset> &clique_list, const int clique_li
         for(int i = 0; i < cliques.size(); i++){
             Bitset &clq = cliques[i];
             //check whether vertex is adjacent to all vertices of clique, i.e. N(v) intersect clq == clq
-            if((gmatrix[v] & clq) == clq) {
+            if(clq.is_subset_of(gmatrix[v])) {
                 clq.set(v);
                 clique_sz[i]++;
                 last_inserted_index[v] = i;
@@ -591,8 +650,7 @@ int MGraph::greedy_cliques(std::vector<Bitset> &clique_list, const int clique_li
         //if not possible to add vertex to existing clique, create new one
         if(not inserted and cliques.size() < clique_limit) {
             last_inserted_index[v] = static_cast<int>(cliques.size());
-            cliques.emplace_back(size);
-            cliques.back().set(v);
+            cliques.emplace_back().set(v);
             clique_sz.push_back(1);
         }
     }
@@ -600,7 +658,7 @@ int MGraph::greedy_cliques(std::vector<Bitset> &clique_list, const int clique_li
     for (int v : vertices) {
         for (int i = last_inserted_index[v]; i < cliques.size(); i++) {
             Bitset &clq = cliques[i];
-            if((gmatrix[v] & clq) == clq) {
+            if(clq.is_subset_of(gmatrix[v])) {
                 clq.set(v);
                 clique_sz[i]++;
                 last_inserted_index[v] = i;
@@ -620,6 +678,28 @@ int MGraph::greedy_cliques(std::vector<Bitset> &clique_list, const int clique_li
     return clique_sz[max_size];
 }
 
+Bitset MGraph::greedy_clique_in(Bitset candidates) const {
+    Bitset clique(size);
+    ScratchArena::Frame frame(scratch);
+    Bitset &common = frame.bitset(size);
+    while (candidates.any()) {
+        int best = -1;
+        std::size_t best_degree = 0;
+        for (int v = candidates.find_first(); v != Bitset::npos; v = candidates.find_next(v)) {
+            common = gmatrix[v];
+            common &= candidates;
+            std::size_t degree = common.count();
+            if (best == -1 or degree > best_degree) {
+                best = v;
+                best_degree = degree;
+            }
+        }
+        clique.set(best);
+        candidates &= gmatrix[best];
+    }
+    return clique;
+}
+
 bool MGraph::is_clique(const Bitset &clique) const {
     assert(clique.size() == size);
     for (int v = clique.find_first(); v != Bitset::npos; v = clique.find_next(v)) {
@@ -644,34 +724,132 @@ MGraph::SubGraph::SubGraph(const Bitset &clique)
 }
 
 
+MGraph::MycielskyCache::MycielskyCache(const int size)
+    : neighborhood(size), S(size), NG_S(size), valid(size),
+      current_neighborhood(size), current_S(size), current_NG_S(size), current_valid(size) {
+}
+
+void MGraph::update_mycielsky_cache(MycielskyCache &cache) {
+    //only the membership of changed vertices u in S_v can be different, and N_G(S_v) if S_v or a row in it changed
+    if (cache.valid.none() or changed_vertices.none()) {
+        changed_vertices.reset();
+        return;
+    }
+    if (changed_vertices.count() * 4 > static_cast<std::size_t>(size)) {
+        //too many changes, recomputing is cheaper
+        cache.valid.reset();
+        changed_vertices.reset();
+        return;
+    }
+    for (auto v = cache.valid.find_first(); v != Bitset::npos; v = cache.valid.find_next(v)) {
+        if (not nodeset[v]) {
+            cache.valid.reset(v);
+            continue;
+        }
+        bool recompute_union = changed_vertices[v];
+        for (auto u = changed_vertices.find_first(); u != Bitset::npos; u = changed_vertices.find_next(u)) {
+            if (u == v) {
+                continue;
+            }
+            bool in_S = nodeset[u] and cache.neighborhood[v].is_subset_of(gmatrix[u]);
+            recompute_union = recompute_union or in_S or cache.S[v][u];
+            cache.S[v][u] = in_S;
+        }
+        if (recompute_union) {
+            cache.NG_S[v] = gmatrix[v];
+            for (auto u = cache.S[v].find_first(); u != Bitset::npos; u = cache.S[v].find_next(u)) {
+                cache.NG_S[v] |= gmatrix[u];
+            }
+        }
+    }
+    changed_vertices.reset();
+}
+
 int MGraph::mycielsky_extension_clique(SubGraph &subgraph, const int threshold) {
+    //one time cache, the changes of the graph are not consumed
+    MycielskyCache cache(size);
+    return mycielsky_extension_clique(subgraph, threshold, cache);
+}
+
+int MGraph::mycielsky_extension_clique(SubGraph &subgraph, const int threshold, MycielskyCache &cache) {
     //function to extend an initial clique to larger generalised mycielsky graph
     // returned is the number of successful iterations and stores reason clause in external_reasons if succesful
     int iterations = 0;
+    assert(static_cast<int>(cache.S.size()) == size);
+    cache.current_valid.reset();
+    ScratchArena::Frame frame(scratch);
+    Bitset &new_S = frame.bitset(size);
+    Bitset &S = frame.bitset(size);
+    Bitset &NG_S = frame.bitset(size);
+
+    //computes S_v for the current N_H(v), starting from the sets of a smaller N_H(v) if there are any,
+    //since S_v only gets smaller if N_H(v) grows
+    auto compute_S = [this, &new_S](const int v, const Bitset &neighborhood, const Bitset *candidates,
+                                    Bitset &S, Bitset &NG_S) {
+        new_S.reset();
+        new_S.set(v);
+        NG_S = gmatrix[v];
+        if (candidates == nullptr) {
+            for (int u : vertices) {
+                if (u != v and neighborhood.is_subset_of(gmatrix[u])) {
+                    new_S.set(u);
+                    NG_S |= gmatrix[u];
+                }
+            }
+        }
+        else {
+            for (auto u = candidates->find_first(); u != Bitset::npos; u = candidates->find_next(u)) {
+                if (static_cast<int>(u) != v and neighborhood.is_subset_of(gmatrix[u])) {
+                    new_S.set(u);
+                    NG_S |= gmatrix[u];
+                }
+            }
+        }
+        //swap instead of copy, new_S is only a buffer
+        std::swap(S, new_S);
+        new_S.resize(size);
+    };
 
-    Bitset W = Bitset(size);
+    Bitset &W = frame.bitset(size);
+    Bitset &NG_w_intersect_S_v = frame.bitset(size);
+    std::vector<int> &new_vertices = frame.ints();
+    std::vector<int> &new_edges = frame.ints(); //pairs of vertices
     while (subgraph.num_vertices < size and iterations < threshold){ //can stop when enough iterations were succesful
         //initialize W=V and S_v = {v}
         W.set();
-        std::vector<Bitset> vecS(subgraph.num_vertices, Bitset(size));
-        for(int i = 0; i < subgraph.num_vertices; i++){
-            int v = subgraph.nodes[i];
-            vecS[i].set(v);
-        }
         //first loop computing S_v and intersecting W
         for(int i = 0; i < subgraph.num_vertices; i++){
             int v = subgraph.nodes[i];
-            Bitset NG_Sv = gmatrix[v]; //so we can skip v in next loop
-            for (int u : vertices) {
-                if(u == v) {
-                    continue;
+            const Bitset &N_H_v = subgraph.matrix[v];
+            if (cache.current_valid[v]) {
+                if (cache.current_neighborhood[v] != N_H_v) {
+                    //N_H(v) grew in the last iteration, refine S_v of the last iteration
+                    compute_S(v, N_H_v, &cache.current_S[v], cache.current_S[v], cache.current_NG_S[v]);
+                    cache.current_neighborhood[v] = N_H_v;
+                }
+            }
+            else {
+                if (not (cache.valid[v] and cache.neighborhood[v] == N_H_v)) {
+                    bool refine = cache.valid[v] and cache.neighborhood[v].is_subset_of(N_H_v);
+                    compute_S(v, N_H_v, refine ? &cache.S[v] : nullptr, S, NG_S);
+                    if (not refine) {
+                        //keep the entry of the smaller neighborhood otherwise, it can be used for more subgraphs
+                        cache.neighborhood[v] = N_H_v;
+                        cache.S[v] = S;
+                        cache.NG_S[v] = NG_S;
+                        cache.valid.set(v);
+                    }
+                    cache.current_S[v] = S;
+                    cache.current_NG_S[v] = NG_S;
                 }
-                if (subgraph.matrix[v].is_subset_of(gmatrix[u])) {
-                    vecS[i].set(u);
-                    NG_Sv |= gmatrix[u]; //union
+                else {
+                    cache.current_S[v] = cache.S[v];
+                    cache.current_NG_S[v] = cache.NG_S[v];
                 }
+                cache.current_neighborhood[v] = N_H_v;
+                cache.current_valid.set(v);
             }
-            W &= NG_Sv; //intersection
+            W &= cache.current_NG_S[v]; //intersection
             if(W.none()){ //W already empty, can stop here
                 break;
             }
@@ -680,8 +858,8 @@ int MGraph::mycielsky_extension_clique(SubGraph &subgraph, const int threshold)
         if(W.any()){
             iterations++;
             //instead of copying the subgraph, we work with current one and remember which vertices/edges to add and do so later
-            std::vector<int> new_vertices;
-            std::vector<std::pair<int, int>> new_edges;
+            new_vertices.clear();
+            new_edges.clear();
             int w = W.find_first();
             if(not subgraph.nodeset[w]) {
                 new_vertices.push_back(w);
@@ -690,15 +868,16 @@ int MGraph::mycielsky_extension_clique(SubGraph &subgraph, const int threshold)
             for(int i = 0; i < subgraph.num_vertices; i++){
                 int v = subgraph.nodes[i];
                 //insert vertex u from the intersection
-                Bitset  NG_w_intersect_S_v = gmatrix[w] & vecS[i];
+                NG_w_intersect_S_v = gmatrix[w];
+                NG_w_intersect_S_v &= cache.current_S[v];
                 int u = NG_w_intersect_S_v.find_first();
                 if(not subgraph.nodeset[u]) {
                     new_vertices.push_back(u);
                 }
                 //add edges between u and w, and u and N_H(v)
-                new_edges.push_back({u,w});
+                new_edges.insert(new_edges.end(), {u, w});
                 for(int vn = subgraph.matrix[v].find_first(); vn != Bitset::npos; vn = subgraph.matrix[v].find_next(vn)){
-                    new_edges.emplace_back(u,vn);
+                    new_edges.insert(new_edges.end(), {u, vn});
                 }
             }
 
@@ -708,9 +887,9 @@ int MGraph::mycielsky_extension_clique(SubGraph &subgraph, const int threshold)
                 subgraph.num_vertices++;
                 subgraph.nodeset.set(u);
             }
-            for (auto [u, vn] : new_edges) {
-                subgraph.matrix[u].set(vn);
-                subgraph.matrix[vn].set(u);
+            for (std::size_t i = 0; i < new_edges.size(); i += 2) {
+                subgraph.matrix[new_edges[i]].set(new_edges[i + 1]);
+                subgraph.matrix[new_edges[i + 1]].set(new_edges[i]);
             }
             std::sort(subgraph.nodes.begin(), subgraph.nodes.end());
         }
@@ -723,9 +902,18 @@ int MGraph::mycielsky_extension_clique(SubGraph &subgraph, const int threshold)
 }
 
 std::vector<Bitset> MGraph::get_active_subgraph(std::vector<int> &index_mapping) const {
-    index_mapping.clear();
+    std::vector<Bitset> active_subgraph;
+    get_active_subgraph(active_subgraph, index_mapping);
+    return active_subgraph;
+}
+
+void MGraph::get_active_subgraph(std::vector<Bitset> &active_subgraph, std::vector<int> &index_mapping) const {
     index_mapping.resize(num_vertices);
-    std::vector<Bitset> active_subgraph(num_vertices, Bitset(num_vertices)); //n by n matrix on active vertices
+    active_subgraph.resize(num_vertices); //n by n matrix on active vertices
+    for(int i = 0; i < num_vertices; i++) {
+        active_subgraph[i].resize(num_vertices);
+        active_subgraph[i].reset();
+    }
     for(int i = 0; i < num_vertices; i++) {
         int active_v = vertices[i];
         index_mapping[i] = active_v;
@@ -737,7 +925,6 @@ std::vector<Bitset> MGraph::get_active_subgraph(std::vector<int> &index_mapping)
             }
         }
     }
-    return active_subgraph;
 }
 
 int MGraph::mnts_clique(std::vector<Bitset> &clique_list, int aim, int mnts_length, int mnts_depth, int random_seed) const {
@@ -755,6 +942,26 @@ int MGraph::mnts_clique(std::vector<Bitset> &clique_list, int aim, int mnts_leng
     return clique_original_graph.count();
 }
 
+int MGraph::mnts_clique(MNTS &engine, std::vector<Bitset> &clique_list, int aim, const Bitset &previous_clique) const {
+    engine.updateGraph(gmatrix, nodeset);
+    //representatives of the previous clique, keeping only those that are still adjacent to all kept ones
+    Bitset seed(size);
+    Bitset candidates = nodeset;
+    for (auto u = previous_clique.find_first(); u != Bitset::npos; u = previous_clique.find_next(u)) {
+        int rep = vertex_rep[u];
+        if (candidates.test(rep)) {
+            seed.set(rep);
+            candidates &= gmatrix[rep];
+        }
+    }
+    engine.setInitialClique(seed);
+    Bitset clique = engine.runSearch(aim);
+    assert(clique.is_subset_of(nodeset));
+    assert(is_clique(clique));
+    clique_list = {clique};
+    return static_cast<int>(clique.count());
+}
+
 
 
 
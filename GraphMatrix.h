@@ -5,12 +5,15 @@
 #include <vector>
 #include <set>
 #include <numeric>
+#include <cstdint>
+#include <algorithm>
 
 #include <boost/dynamic_bitset.hpp>
 
 using Bitset = boost::dynamic_bitset<>;
 
 #include "mnts.h"
+#include "ScratchArena.h"
 
 
 //class that uses matrix representation for a graph
@@ -27,6 +30,8 @@ public:
     std::vector<Bitset> gmatrix; //adjacency matrix
     Bitset nodeset; //0 or 1 whether vertex is still in graph (or was contracted)
     std::vector<int> vertices; //store list of vertices for fast iteration
+    //vertices whose row in gmatrix or membership in nodeset changed since the mycielski cache was last updated
+    Bitset changed_vertices;
 
     //contraction data, mostly the bags for each vertex and a representation of a bag
     //we take the smallest of the vertices in a bag to be the representative
@@ -69,17 +74,24 @@ public:
     void print();
 
     //function to use sequential greedy like algorithms to compute colorings on current graph
-    [[nodiscard]] int dsatur_coloring(const Bitset &clique) const;
-    [[nodiscard]] int sequential_coloring(const Bitset &clique) const;
-    [[nodiscard]] int IS_extract(const Bitset &clique) const;
-    [[nodiscard]] int ISEQ() const;
-    bool try_recolor(int vertex, std::vector<Bitset> &coloring) const;
+    //return the number of colors and write the color of each remaining vertex into vertex_color (-1 for contracted ones)
+    int dsatur_coloring(const Bitset &clique, std::vector<int> &vertex_color) const;
+    int sequential_coloring(const Bitset &clique, std::vector<int> &vertex_color) const;
+    int IS_extract(const Bitset &clique, std::vector<int> &vertex_color) const;
+    int ISEQ(std::vector<int> &vertex_color) const;
+    //helper to write color classes given as bitsets into vertex_color
+    void color_classes_to_vertex_colors(const BitsetList &color_classes, std::vector<int> &vertex_color) const;
+    bool try_recolor(int vertex, BitsetList &coloring) const;
+    //buffers for the coloring, clique and mycielsky routines, which are called at every node of the search
+    mutable ScratchArena scratch;
 
 
     //function to greedily compute cliques in the graph of the current zykov node,
     // writes cliques into passed vector and returns the size of the largest clique
     // (all cliques returned are maximal and of largest size)
     int greedy_cliques(std::vector<Bitset> &clique_list, int clique_limit);
+    //greedy clique among the candidates, always takes the candidate with the most neighbours among the remaining ones
+    [[nodiscard]] Bitset greedy_clique_in(Bitset candidates) const;
     [[nodiscard]] bool is_clique(const Bitset &clique) const;
 
     //struct and fuction to compute mycielsky extension of a clique in the current graph
@@ -94,13 +106,36 @@ public:
             : matrix(size, Bitset(size)), nodeset(size) {}
         explicit SubGraph(const Bitset& clique);
     };
+    //the sets S_v = {v} + {u : N_H(v) subset of N_G(u)} and the union of their neighborhoods N_G(S_v),
+    //kept for the neighborhood N_H(v) they were computed for, so they can be reused for the same clique at later calls
+    //and refined instead of recomputed if N_H(v) grows, they are topped up with the changed_vertices of the graph
+    struct MycielskyCache {
+        std::vector<Bitset> neighborhood;
+        std::vector<Bitset> S;
+        std::vector<Bitset> NG_S;
+        Bitset valid;
+        //the same for the sets of the current extension, whose N_H(v) grows with every iteration
+        std::vector<Bitset> current_neighborhood;
+        std::vector<Bitset> current_S;
+        std::vector<Bitset> current_NG_S;
+        Bitset current_valid;
+        explicit MycielskyCache(int size = 0);
+    };
     //function that tries to extend a given clique into generalised mycielsky subgraph, returns number of succesful iterations
     int mycielsky_extension_clique(SubGraph &subgraph, int threshold);
+    //same, but using and updating a cache that is kept over several calls
+    int mycielsky_extension_clique(SubGraph &subgraph, int threshold, MycielskyCache &cache);
+    void update_mycielsky_cache(MycielskyCache &cache);
 
     //build adjacency matrix only for the active vertices and store the mapping of indices
     std::vector<Bitset> get_active_subgraph(std::vector<int>& index_mapping) const;
+    //same, but writes into active_subgraph and reuses its memory
+    void get_active_subgraph(std::vector<Bitset>& active_subgraph, std::vector<int>& index_mapping) const;
     //use mnts heuristic to find clique
     int mnts_clique(std::vector<Bitset> &clique_list, int aim, int mnts_length, int mnts_depth, int random_seed = 12345) const;
+    //same with a persistent engine that only updates the changed part of the graph, and starts from previous_clique
+    //(given on vertices of an earlier node and mapped through vertex_rep)
+    int mnts_clique(MNTS &engine, std::vector<Bitset> &clique_list, int aim, const Bitset &previous_clique) const;
 
 };
 
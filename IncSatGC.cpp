@@ -5,11 +5,10 @@ UpperTriangle::UpperTriangle() : dimension(0){
     //default constructor
 }
 
-UpperTriangle::UpperTriangle(int dimension, int value) : dimension(dimension){
-    //number of element of upper triangular matrix without diagonal
-    int num_elements = (dimension-1) * dimension / 2;
-    sij_indices.resize(num_elements, value);
-    index_to_ij.resize(num_elements);
+UpperTriangle::UpperTriangle(int dimension, long long num_pairs) : dimension(dimension){
+    row_begin.resize(std::max(dimension, 0), 0);
+    columns.reserve(num_pairs);
+    rows.reserve(num_pairs);
 }
 
 
@@ -17,7 +16,7 @@ IncSatGC::IncSatGC(const char *filename, Options options) :
         IncSatGC(Graph::Graph(filename), std::move(options)) //build graph and call other constructor with that
 {}
 
-IncSatGC::IncSatGC(Graph::Graph in_graph, Options options_) :
+IncSatGC::IncSatGC(Graph::Graph in_graph, Options options_, bool is_subproblem) :
         graph(std::move(in_graph)),
         num_vertices(static_cast<int>(graph.ncount())),
         options(std::move(options_)),
@@ -37,9 +36,10 @@ IncSatGC::IncSatGC(Graph::Graph in_graph, Options options_) :
         num_removable_cj(0),
         is_removable_cj({}),
         current_best_coloring({}),
-        solved_in_preprocessing(false)
+        solved_in_preprocessing(false),
+        is_subproblem(is_subproblem)
 {
-    if(options.verbosity >= Options::Normal) {
+    if(options.verbosity >= Options::Normal and not is_subproblem) {
         options.print_header();
         options.print();
     }
@@ -52,9 +52,11 @@ IncSatGC::IncSatGC(Graph::Graph in_graph, Options options_) :
     stats.heuristic_bound = heuristic_bound;
     new_SAT_solver();
 
-    //for writing cleanup on exit/interrupt
-    INSTANCE = this;
-    register_write_cleanup_on_exit();
+    //for writing cleanup on exit/interrupt, only done by the main instance
+    if(not is_subproblem) {
+        INSTANCE = this;
+        register_write_cleanup_on_exit();
+    }
 }
 
 
@@ -70,6 +72,16 @@ int IncSatGC::run() {
             write_and_cleanup();
             return lower_bound;
         }
+        //solve blocks of the graph separately if it decomposes
+        if(options.decompose_graph and solve_by_decomposition()){
+            assert(lower_bound == upper_bound);
+            if(options.verbosity >= Options::Normal) {
+                std::cout << "Result: Chromatic number of " << lower_bound << " was determined by graph decomposition.\n";
+            }
+            stats.end_phase(Statistics::Total);
+            write_and_cleanup();
+            return lower_bound;
+        }
     }
 
     //main execution of algorithm to find chromatic number
@@ -86,49 +98,65 @@ void IncSatGC::preprocessing(){
     stats.start_phase(Statistics::Preprocessing);
     stats.original_graph_size = {graph.ncount(), graph.ecount(), graph.density()};
 
+    //independent bounds run next to the sequential steps, pieces of a decomposed graph are already solved in parallel
+    bool concurrent = options.num_threads > 1 and not is_subproblem;
+    if (concurrent) {
+        start_concurrent_bounds();
+    }
     //get lower bounds on chromatic number and compute first initial coloring
     preprocessing_clique_bound();
-    preprocessing_mycielsky_bound();
+    if (not concurrent) {
+        preprocessing_mycielsky_bound();
+    }
     preprocessing_initial_coloring();
+    //mycielski bound reads the graph, so it has to be done before the reductions change it
+    if (mycielsky_task.valid()) {
+        auto [mycielsky_bound, mycielsky_time] = mycielsky_task.get();
+        stats.add_mycielsky_time(mycielsky_time);
+        notify_mycielsky_lb(mycielsky_bound);
+    }
     //check if that already solved the graph
-    if(lower_bound == upper_bound){
-        solved_in_preprocessing = true;
-        stats.solved = true;
-        stats.solved_in_preprocessing = solved_in_preprocessing;
+    if(check_solved_in_preprocessing()){
         return;
     }
     //use bound and dominated vertices to reduce graph
     if( options.reduce_graph ){
         preprocessing_reductions();
     }
+    collect_concurrent_bounds(false);
     //find an initial coloring solution and upper bound
     if(not solved_in_preprocessing) {
         preprocessing_initial_coloring();
+        preprocessing_local_search();
     }
-    if(lower_bound == upper_bound){
-        solved_in_preprocessing = true;
-        stats.solved = true;
-        stats.solved_in_preprocessing = solved_in_preprocessing;
+    if(check_solved_in_preprocessing()){
         return;
     }
+    //lift the lower bound on small subgraphs before the encoding of the whole graph is built
+    if (options.core_lower_bound) {
+        preprocessing_core_lower_bound();
+        if(check_solved_in_preprocessing()){
+            return;
+        }
+    }
     //permute the graph if option is set
     if ((not solved_in_preprocessing) and options.use_clique_in_ordering) {
         preprocessing_clique_ordering();
     }
     //compute fractional chromatic number as initial bound (with a timeout)
-    if (not solved_in_preprocessing) {
-        frac_lower_bound = external_get_fractional();
+    if (fractional_task.valid()) {
+        collect_concurrent_bounds(true);
+    }
+    else if (not solved_in_preprocessing) {
+        //pieces of a decomposed graph don't have an input file
+        frac_lower_bound = external_get_fractional(has_removed_vertices_in_reduction or is_subproblem);
         notify_lower_bound(frac_lower_bound);
         if (options.verbosity >= Options::Debug) {
             std::cout << "c Initial fractional lower bound of " << std::setprecision(25) << frac_lower_bound << std::setprecision(5)
                       << " in " << stats.duration_of(Statistics::PreprocessingFractional) <<  "\n";
         }
-        if(lower_bound == upper_bound){
-            solved_in_preprocessing = true;
-            stats.solved = true;
-            stats.solved_in_preprocessing = solved_in_preprocessing;
-        }
     }
+    check_solved_in_preprocessing();
 
     if (options.verbosity >= Options::Normal) {
         std::cout << "c Found lb " << lower_bound << " and ub " << upper_bound <<
@@ -143,6 +171,358 @@ void IncSatGC::preprocessing(){
     stats.end_phase(Statistics::Preprocessing);
 }
 
+void IncSatGC::start_concurrent_bounds() {
+    cancel_preprocessing = false;
+    if (options.use_mycielsky_lb) {
+        //only reads the graph, which is not changed before the reductions
+        //the phases are timed with the cpu time of the whole process, so the task measures its own wall time
+        //and leaves the statistics and the output to the main thread
+        mycielsky_task = std::async(std::launch::async, [this]() {
+            auto start = std::chrono::steady_clock::now();
+            int mycielsky_bound = mycielsky_extension_lb(SubGraph({{0, Bitset(num_vertices)}}));
+            return std::make_pair(mycielsky_bound, Duration(std::chrono::steady_clock::now() - start));
+        });
+    }
+    //the fractional bound of the input graph is also a bound for the reduced graph, so exactcolors can start right away
+    fractional_task = std::async(std::launch::async, [this]() {
+        return external_get_fractional(false);
+    });
+}
+
+void IncSatGC::collect_concurrent_bounds(const bool wait) {
+    //tasks still running are no longer needed once the chromatic number is known
+    if (lower_bound == upper_bound) {
+        cancel_preprocessing = true;
+    }
+    if (fractional_task.valid() and
+        (wait or fractional_task.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+        int fractional_bound = fractional_task.get();
+        if (not cancel_preprocessing) {
+            frac_lower_bound = fractional_bound;
+            notify_lower_bound(frac_lower_bound);
+            if (options.verbosity >= Options::Debug) {
+                std::cout << "c Initial fractional lower bound of " << frac_lower_bound
+                          << " (computed concurrently) at " << stats.current_total_time() << "\n";
+            }
+        }
+    }
+    if (lower_bound == upper_bound) {
+        cancel_preprocessing = true;
+    }
+}
+
+bool IncSatGC::check_solved_in_preprocessing() {
+    collect_concurrent_bounds(false);
+    if(lower_bound == upper_bound){
+        //stop the remaining concurrent tasks, the future destructor waits for them to finish
+        cancel_preprocessing = true;
+        fractional_task = {};
+        solved_in_preprocessing = true;
+        stats.solved = true;
+        stats.solved_in_preprocessing = solved_in_preprocessing;
+        return true;
+    }
+    return false;
+}
+
+std::vector<IncSatGC::GraphPiece> IncSatGC::decompose_graph() const {
+    //the blocks of a graph are its biconnected components, which also splits up different connected components
+    //two blocks share at most a cut vertex, which is a clique separator, so the chromatic number is the max over all blocks
+    using UndirectedGraph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS,
+            boost::no_property, boost::property<boost::edge_index_t, std::size_t>>;
+    UndirectedGraph boost_graph(num_vertices);
+    std::vector<Graph::VertexType> elist = graph.elist();
+    for (int i = 0; i < graph.ecount(); ++i) {
+        boost::add_edge(elist[2 * i], elist[2 * i + 1], static_cast<std::size_t>(i), boost_graph);
+    }
+    std::vector<std::size_t> block_of_edge(graph.ecount());
+    auto edge_block = boost::make_iterator_property_map(block_of_edge.begin(), boost::get(boost::edge_index, boost_graph));
+    std::size_t num_blocks = boost::biconnected_components(boost_graph, edge_block);
+
+    //collect vertices and edges of each block, isolated vertices form a block on their own
+    std::vector<std::vector<Graph::VertexType>> block_vertices(num_blocks);
+    std::vector<std::vector<Graph::VertexType>> block_edges(num_blocks);
+    std::vector<bool> has_edge(num_vertices, false);
+    for (auto [e, e_end] = boost::edges(boost_graph); e != e_end; ++e) {
+        std::size_t block = edge_block[*e];
+        Graph::VertexType u = static_cast<Graph::VertexType>(boost::source(*e, boost_graph));
+        Graph::VertexType v = static_cast<Graph::VertexType>(boost::target(*e, boost_graph));
+        block_vertices[block].push_back(u);
+        block_vertices[block].push_back(v);
+        block_edges[block].push_back(u);
+        block_edges[block].push_back(v);
+        has_edge[u] = has_edge[v] = true;
+    }
+    for (Graph::VertexType v = 0; v < num_vertices; ++v) {
+        if(not has_edge[v]) {
+            block_vertices.push_back({v});
+            block_edges.emplace_back();
+        }
+    }
+
+    std::vector<GraphPiece> pieces;
+    pieces.reserve(block_vertices.size());
+    for (std::size_t b = 0; b < block_vertices.size(); ++b) {
+        std::vector<Graph::VertexType> &vertices = block_vertices[b];
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        //relabel edges by the position of their vertices in the block
+        for (Graph::VertexType &v : block_edges[b]) {
+            v = static_cast<Graph::VertexType>(std::lower_bound(vertices.begin(), vertices.end(), v) - vertices.begin());
+        }
+        auto num_vertices_block = static_cast<Graph::VertexType>(vertices.size());
+        auto num_edges_block = static_cast<Graph::VertexType>(block_edges[b].size() / 2);
+        pieces.push_back({std::move(vertices), Graph::Graph(num_vertices_block, num_edges_block, std::move(block_edges[b]))});
+    }
+    return pieces;
+}
+
+bool IncSatGC::solve_by_decomposition() {
+    std::vector<GraphPiece> pieces = decompose_graph();
+    if(pieces.size() <= 1) {
+        return false;
+    }
+    stats.start_phase(Statistics::Algorithm);
+    stats.num_decomposition_pieces = static_cast<int>(pieces.size());
+    //large pieces first, they likely determine the chromatic number and let us skip the smaller ones
+    std::sort(pieces.begin(), pieces.end(), [](const GraphPiece &a, const GraphPiece &b) {
+        return a.graph.ncount() > b.graph.ncount();
+    });
+    if(options.verbosity >= Options::Verbose) {
+        std::cout << "c Decomposition: graph has " << pieces.size() << " blocks, the largest has "
+                  << pieces.front().graph.ncount() << " vertices\n";
+    }
+
+    //shared state of the workers, the lower bound of the whole graph is the max over the solved pieces
+    std::mutex decomposition_mutex;
+    int decomposition_lb = lower_bound;
+    std::atomic<std::size_t> next_piece{0};
+    std::vector<Graph::Coloring> piece_colorings(pieces.size());
+    std::exception_ptr worker_exception = nullptr;
+
+    auto solve_pieces = [&]() {
+        try {
+            for (std::size_t i = next_piece++; i < pieces.size(); i = next_piece++) {
+                const GraphPiece &piece = pieces[i];
+                Graph::Permutation ordering;
+                Graph::Coloring coloring = piece.graph.dsatur(ordering);
+                int trivial_lb = 1 + (piece.graph.ecount() > 0);
+                int known_lb;
+                {
+                    std::lock_guard<std::mutex> lock(decomposition_mutex);
+                    known_lb = decomposition_lb;
+                }
+                //piece can't increase the chromatic number, heuristic coloring is good enough
+                if(static_cast<int>(coloring.size()) <= std::max(known_lb, trivial_lb)) {
+                    piece_colorings[i] = std::move(coloring);
+                    continue;
+                }
+                //solve the piece with its own instance, writing nothing and using a unique name for temporary files
+                Options piece_options = options;
+                piece_options.verbosity = Options::Quiet;
+                piece_options.decompose_graph = false;
+                piece_options.num_threads = 1;
+                piece_options.stats_csvfile.clear();
+                piece_options.coloringfilepath.clear();
+                piece_options.filename = options.filename + "_piece" + std::to_string(i);
+                IncSatGC piece_instance(piece.graph, piece_options, true);
+                int piece_chromatic_number = piece_instance.solve_subproblem();
+                Graph::Coloring piece_coloring = piece_instance.recover_optimal_coloring();
+                assert(static_cast<int>(piece_coloring.size()) == piece_chromatic_number);
+
+                std::lock_guard<std::mutex> lock(decomposition_mutex);
+                decomposition_lb = std::max(decomposition_lb, piece_chromatic_number);
+                piece_colorings[i] = std::move(piece_coloring);
+                stats.num_solved_pieces++;
+                //the SAT calls of the pieces are reported for the whole graph
+                stats.add_search_stats(piece_instance.stats);
+                if(options.verbosity >= Options::Debug) {
+                    std::cout << "c Decomposition: block " << i << " with " << piece.graph.ncount()
+                              << " vertices has chromatic number " << piece_chromatic_number << "\n";
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(decomposition_mutex);
+            worker_exception = std::current_exception();
+            next_piece = pieces.size(); //stop the other workers
+        }
+    };
+    int num_workers = std::min(options.num_threads, static_cast<int>(pieces.size()));
+    std::vector<std::thread> workers;
+    for (int t = 1; t < num_workers; ++t) {
+        workers.emplace_back(solve_pieces);
+    }
+    solve_pieces();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    if(worker_exception) {
+        std::rethrow_exception(worker_exception);
+    }
+
+    //glue colorings along the block-cut tree, a block reached over a cut vertex shares only that vertex with the
+    // already colored blocks, so swapping two of its colors makes the colorings agree on the cut vertex
+    std::vector<std::vector<int>> pieces_of_vertex(num_vertices);
+    for (int i = 0; i < static_cast<int>(pieces.size()); ++i) {
+        for (Graph::VertexType v : pieces[i].vertices) {
+            pieces_of_vertex[v].push_back(i);
+        }
+    }
+    ColorMap glued_coloring(num_vertices, NoColor);
+    std::vector<bool> reached(pieces.size(), false);
+    std::queue<int> piece_queue;
+    int num_colors = 0;
+    for (int start = 0; start < static_cast<int>(pieces.size()); ++start) {
+        if(reached[start]) {
+            continue;
+        }
+        reached[start] = true;
+        piece_queue.push(start);
+        while(not piece_queue.empty()) {
+            int i = piece_queue.front();
+            piece_queue.pop();
+            const GraphPiece &piece = pieces[i];
+            ColorMap piece_colors(piece.vertices.size(), NoColor);
+            for (int c = 0; c < static_cast<int>(piece_colorings[i].size()); ++c) {
+                for (Graph::VertexType v : piece_colorings[i][c]) {
+                    piece_colors[v] = c;
+                }
+            }
+            //map the color of the shared vertex onto the color it already has
+            std::vector<int> color_map(std::max(static_cast<int>(piece_colorings[i].size()), num_colors));
+            std::iota(color_map.begin(), color_map.end(), 0);
+            for (int local = 0; local < static_cast<int>(piece.vertices.size()); ++local) {
+                Graph::VertexType v = piece.vertices[local];
+                if(glued_coloring[v] != NoColor) {
+                    std::swap(color_map[piece_colors[local]], color_map[glued_coloring[v]]);
+                    break;
+                }
+            }
+            for (int local = 0; local < static_cast<int>(piece.vertices.size()); ++local) {
+                Graph::VertexType v = piece.vertices[local];
+                assert(glued_coloring[v] == NoColor or glued_coloring[v] == color_map[piece_colors[local]]);
+                glued_coloring[v] = color_map[piece_colors[local]];
+                num_colors = std::max(num_colors, glued_coloring[v] + 1);
+                for (int neighbor_piece : pieces_of_vertex[v]) {
+                    if(not reached[neighbor_piece]) {
+                        reached[neighbor_piece] = true;
+                        piece_queue.push(neighbor_piece);
+                    }
+                }
+            }
+        }
+    }
+    assert(is_valid_coloring(glued_coloring));
+
+    current_best_coloring = glued_coloring;
+    notify_lower_bound(decomposition_lb);
+    notify_upper_bound(num_colors);
+    assert(lower_bound == upper_bound);
+    stats.solved = true;
+    if(options.verbosity >= Options::Verbose) {
+        std::cout << "c Decomposition: solved " << stats.num_solved_pieces << " of " << pieces.size()
+                  << " blocks, the others were colored within the lower bound\n";
+    }
+    stats.end_phase(Statistics::Algorithm);
+    return true;
+}
+
+int IncSatGC::solve_subproblem() {
+    stats.start_phase(Statistics::Total);
+    if(not options.disable_preprocessing){
+        preprocessing();
+        if(solved_in_preprocessing){
+            assert(lower_bound == upper_bound);
+            stats.end_phase(Statistics::Total);
+            return lower_bound;
+        }
+    }
+    int chromatic_number = compute_chromatic_number();
+    stats.end_phase(Statistics::Total);
+    return chromatic_number;
+}
+
+int IncSatGC::hybrid_search() {
+    assert(options.solver == Options::CaDiCaL);
+    SharedBounds shared(lower_bound, upper_bound, current_best_coloring);
+    std::exception_ptr search_exception = nullptr;
+
+    auto search = [&](const Options::SearchStrategy strategy) {
+        try {
+            //the searches work on the preprocessed graph, they only differ in the strategy
+            Options search_options = options;
+            search_options.strategy = strategy;
+            search_options.verbosity = Options::Quiet;
+            search_options.decompose_graph = false;
+            search_options.num_threads = std::max(1, options.num_threads / 2);
+            search_options.stats_csvfile.clear();
+            search_options.coloringfilepath.clear();
+            search_options.filename = options.filename + (strategy == Options::TopDown ? "_top_down" : "_bottom_up");
+            IncSatGC search_instance(graph, search_options, true);
+            search_instance.clique = clique;
+            search_instance.current_best_coloring = current_best_coloring;
+            search_instance.notify_lower_bound(lower_bound);
+            search_instance.notify_upper_bound(upper_bound);
+            search_instance.frac_lower_bound = frac_lower_bound;
+            search_instance.flag_fractional_timed_out = flag_fractional_timed_out;
+            //new solver that has the shared bounds connected as terminator
+            search_instance.shared_bounds = &shared;
+            search_instance.reset_SAT_solver();
+            try {
+                search_instance.compute_chromatic_number();
+            } catch (const SearchStopped &) {
+                //the other search settled the chromatic number first
+            }
+            //the SAT calls of both searches are reported for this instance
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            stats.add_search_stats(search_instance.stats);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            search_exception = std::current_exception();
+            shared.stop = true; //stop the other search
+        }
+    };
+    std::thread bottom_up_thread(search, Options::BottomUp);
+    search(Options::TopDown);
+    bottom_up_thread.join();
+    if(search_exception) {
+        std::rethrow_exception(search_exception);
+    }
+
+    current_best_coloring = shared.coloring;
+    notify_lower_bound(shared.lower_bound);
+    notify_upper_bound(shared.upper_bound);
+    assert(current_best_coloring.empty() or is_valid_coloring(current_best_coloring));
+    if(options.verbosity >= Options::Normal and shared.settled_by != Options::Hybrid) {
+        std::cout << "c Hybrid: the " << Options::tostr_strategy[shared.settled_by] << " search settled the chromatic number of "
+                  << upper_bound << " at " << stats.current_total_time() << "\n";
+    }
+    stats.solved = true;
+    return upper_bound;
+}
+
+void IncSatGC::share_bounds() {
+    if(shared_bounds == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(shared_bounds->mutex);
+    bool was_open = shared_bounds->lower_bound < shared_bounds->upper_bound;
+    if(lower_bound > shared_bounds->lower_bound) {
+        shared_bounds->lower_bound = lower_bound;
+    }
+    //the own upper bound is only below the shared one if it was found by this search, so the coloring belongs to it
+    if(upper_bound < shared_bounds->upper_bound) {
+        shared_bounds->coloring = current_best_coloring;
+        shared_bounds->upper_bound = upper_bound;
+    }
+    if(was_open and shared_bounds->lower_bound >= shared_bounds->upper_bound) {
+        shared_bounds->settled_by = options.strategy;
+    }
+    //the k the other search settled are skipped by the loops since they run until lower_bound == upper_bound
+    notify_lower_bound(shared_bounds->lower_bound);
+    notify_upper_bound(shared_bounds->upper_bound);
+}
+
 int IncSatGC::compute_chromatic_number() {
     stats.start_phase(Statistics::Algorithm);
     if(options.original_paper_configuration) {
@@ -151,6 +531,12 @@ int IncSatGC::compute_chromatic_number() {
         assert(lower_bound == upper_bound);
         return upper_bound;
     }
+    if(options.strategy == Options::Hybrid) {
+        hybrid_search();
+        stats.end_phase(Statistics::Algorithm);
+        assert(lower_bound == upper_bound);
+        return upper_bound;
+    }
     switch (options.encoding) {
         case Options::AssignmentEncoding:
             do_assignment_encoding();
@@ -170,6 +556,9 @@ int IncSatGC::compute_chromatic_number() {
         case Options::ZykovPropagator:
             do_zykov_propagator();
             break;
+        case Options::AssignmentPropagator:
+            do_assignment_propagator();
+            break;
         default:
             throw std::runtime_error("Invalid option for encoding.");
     }
@@ -193,9 +582,15 @@ void IncSatGC::new_SAT_solver() {
         throw std::runtime_error("Solver should be NULL when initialising new solver.");
     }
     switch (options.solver) {
-        case Options::CaDiCaL:
-            solver = std::make_shared<CaDiCaLAdaptor::Solver>();
+        case Options::CaDiCaL: {
+            auto cadical = std::make_shared<CaDiCaLAdaptor::Solver>();
+            if (shared_bounds != nullptr) {
+                //hybrid strategy, stop the SAT call once the other search settled the chromatic number
+                cadical->solver.connect_terminator(shared_bounds);
+            }
+            solver = cadical;
             break;
+        }
         case Options::Glucose:
             solver = std::make_shared<NSPACE::Solver>();//using SimpSolver breaks things but I don't know why
             solver->verbosity = 0;
@@ -216,6 +611,7 @@ void IncSatGC::reset_SAT_solver() {
     solver = nullptr;
     //propagators are reset automatically when a new one is assigned since unqie_ptr is used
     new_SAT_solver();
+    phase_coloring.clear();
 }
 
 void IncSatGC::add_vars(const int num_vars) {
@@ -278,8 +674,22 @@ bool IncSatGC::run_solver() {
             throw std::runtime_error("Solver* was of the wrong type.");
         }
 
+        if (options.phase_from_coloring) {
+            set_phases_from_coloring(*cast_solver);
+        }
         cast_solver->assume(encoder_assumptions);
         int result = cast_solver->solver.solve();
+        if (result == CaDiCaL::Status::UNKNOWN and not search_coloring.empty()) {
+            //propagator stopped the solver after finding a coloring with few enough colors
+            stats.end_phase(Statistics::SatSolver);
+            return true;
+        }
+        if (result == CaDiCaL::Status::UNKNOWN and shared_bounds != nullptr and shared_bounds->terminate()) {
+            //hybrid strategy, the other search settled the chromatic number during this call, or the time budget
+            // of a core subgraph ran out
+            stats.end_phase(Statistics::SatSolver);
+            throw SearchStopped();
+        }
         if (result == CaDiCaL::Status::UNKNOWN) {//solver inconclusive, cadical returns code 0
             throw std::runtime_error("Problem unsolved by CaDiCal.");
         }
@@ -294,6 +704,72 @@ bool IncSatGC::run_solver() {
         throw std::runtime_error("Invalid option for solver.");
 }
 
+void IncSatGC::set_phases_from_coloring(CaDiCaLAdaptor::Solver &cadical) {
+    if (current_best_coloring.size() != static_cast<std::size_t>(num_vertices) or current_best_coloring == phase_coloring) {
+        return;
+    }
+    phase_coloring = current_best_coloring;
+    const ColorMap &colors = phase_coloring;
+    switch (options.encoding) {
+        case Options::FullEncoding:
+        case Options::CEGAR:
+        case Options::ZykovPropagator: {
+            //s_ij is true iff i and j have the same color, c_j iff j is the smallest vertex of its color class
+            std::vector<bool> color_seen(num_vertices, false);
+            for (int j = 0; j < num_vertices; ++j) {
+                for (int i : complement_graph_adjacency[j]) {
+                    if (i < j) {
+                        cadical.phase(mkLit(sij_indices.get(i, j), colors[i] != colors[j]));
+                    }
+                }
+                bool is_first = not color_seen[colors[j]];
+                color_seen[colors[j]] = true;
+                if (j > 0 and not c_indices.empty() and
+                    not (options.encoding == Options::ZykovPropagator and options.disable_cardinality_constraints)) {
+                    cadical.phase(mkLit(c_indices[j - 1], not is_first));
+                }
+            }
+            break;
+        }
+        case Options::AssignmentEncoding:
+        case Options::AssignmentPropagator:
+        case Options::PartialOrderEncoding: {
+            //the encodings fix the i-th clique vertex to color i, so permute the colors to agree with that
+            std::vector<int> new_color(num_vertices, NoColor);
+            std::vector<bool> is_used(num_vertices, false);
+            for (int index = 0; index < static_cast<int>(clique.size()); ++index) {
+                new_color[colors[clique[index]]] = index;
+                is_used[index] = true;
+            }
+            int next_color = 0;
+            for (int v = 0; v < num_vertices; ++v) {
+                if (new_color[colors[v]] == NoColor) {
+                    while (is_used[next_color]) next_color++;
+                    new_color[colors[v]] = next_color;
+                    is_used[next_color] = true;
+                }
+            }
+            //x_v,j is true iff v has color j, y_v,j iff the color of v is larger than j
+            //colors that don't exist in the encoding leave all variables of the vertex false
+            const int num_colors = direct_encoding_num_colors;
+            for (int v = 0; v < num_vertices; ++v) {
+                for (int j = 0; j < num_colors; ++j) {
+                    bool value = options.encoding != Options::PartialOrderEncoding ? new_color[colors[v]] == j
+                                                                                    : new_color[colors[v]] > j;
+                    cadical.phase(mkLit(num_colors * v + j, not value));
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    if (options.verbosity >= Options::Verbose) {
+        std::cout << "c Set solver phases from a coloring with "
+                  << *std::max_element(colors.begin(), colors.end()) + 1 << " colors\n";
+    }
+}
+
 void IncSatGC::write_cnf() {
     assert(options.strategy == Options::SingleK and options.specific_num_colors.has_value());
 
@@ -311,6 +787,7 @@ void IncSatGC::write_cnf() {
         case Options::FullMaxSAT:
         case Options::CEGAR:
         case Options::ZykovPropagator:
+        case Options::AssignmentPropagator:
         default:
             std::cout << "Writing of cnf not supported for the given encoding\n";
             return;
@@ -324,7 +801,31 @@ void IncSatGC::write_cnf() {
         if (not cast_solver) { //solver ptr was not of type CaDiCaLAdaptor::Solver
             throw std::runtime_error("Solver* was of the wrong type.");
         }
-        cast_solver->solver.write_dimacs(cnf_name.c_str());
+        //clauses are traversed twice, first to count them for the header and then to write them
+        struct ClauseCounter : CaDiCaL::ClauseIterator {
+            long long num_clauses = 0;
+            bool clause(const std::vector<int> &) override {
+                num_clauses++;
+                return true;
+            }
+        } counter;
+        cast_solver->solver.traverse_clauses(counter);
+
+        if (options.compress_output) {
+            cnf_name += ".gz";
+        }
+        ClauseWriter cnf(cnf_name, options.compress_output);
+        struct ClauseSink : CaDiCaL::ClauseIterator {
+            ClauseWriter &cnf;
+            explicit ClauseSink(ClauseWriter &cnf) : cnf(cnf) {}
+            bool clause(const std::vector<int> &literals) override {
+                cnf.clause(literals.data(), literals.size());
+                return true;
+            }
+        } sink(cnf);
+        cnf.cnf_header(cast_solver->solver.vars(), counter.num_clauses);
+        cast_solver->solver.traverse_clauses(sink);
+        cnf.close();
     }
     else if (options.solver == Options::Glucose){
         solver->toDimacs(cnf_name.c_str());
@@ -372,19 +873,17 @@ std::vector<Graph::VertexType> IncSatGC::external_get_clique(bool write_graph_ge
     std::vector<Graph::VertexType> CliSAT_clique;
     namespace bp = boost::process::v1;
 
-    //first check that external CliSAT binary for cliques exists
+    //first check that external CliSAT binary for cliques exists, otherwise compute the clique in process
     std::filesystem::path CliSAT_path;
 #ifdef CLISAT_BINARY_PATH
     CliSAT_path = CLISAT_BINARY_PATH;
-    if (not std::filesystem::exists(CliSAT_path)) {
-        throw std::runtime_error("The external CliSAT binary does not exist at the specified path.");
-    }
-#else
-    std::cout << "WARNING: CliSAT binary was not specified so the algorithm does not use an initial clique, "
-                 "likely degrading performance significantly.\n";
-    return {};
 #endif
+    if (options.internal_clique_solver or CliSAT_path.empty() or not std::filesystem::exists(CliSAT_path)) {
+        return internal_get_clique(write_graph_get_clique);
+    }
 
+    //pieces of a decomposed graph don't have an input file
+    write_graph_get_clique = write_graph_get_clique or is_subproblem;
     std::string tmp_name;
     if(write_graph_get_clique){
         //write current problem graph to file, so we can run CliSAT
@@ -463,6 +962,47 @@ std::vector<Graph::VertexType> IncSatGC::external_get_clique(bool write_graph_ge
     return CliSAT_clique;
 }
 
+std::vector<Graph::VertexType> IncSatGC::internal_get_clique(bool reduced_graph) {
+    //the in-process solver runs in this process, so its time is not added as child time like that of CliSAT
+    stats.start_phase(Statistics::PreprocessingClique);
+    //get graph representation as vector of bitsets
+    std::vector<Bitset> matrix(num_vertices, Bitset(num_vertices));
+    auto elist = graph.elist();
+    for(int i = 0; i < graph.ecount(); i++){
+        matrix[elist[2 * i]].set( elist[2 * i + 1]);
+        matrix[elist[2 * i + 1]].set( elist[2 * i]);
+    }
+    MaxClique max_clique(matrix);
+    //the clique from before the reductions is a good starting point, if it survived them
+    std::vector<int> initial_clique;
+    if(reduced_graph) {
+        std::vector<Graph::VertexType> remapping = graph.get_remapping();
+        for (Graph::VertexType v : clique) {
+            Graph::VertexType w = remapping.empty() ? v : remapping[v];
+            if (w != Graph::UndefVertex) initial_clique.push_back(static_cast<int>(w));
+        }
+    }
+    std::vector<int> found = max_clique.solve(options.clique_time_limit, -1, initial_clique);
+    std::vector<Graph::VertexType> result(found.begin(), found.end());
+    stats.end_phase(Statistics::PreprocessingClique);
+
+    //print results
+    if(options.verbosity >= Options::Verbose) {
+        std::cout << "c Clique: " << (reduced_graph ? "[In reduced Graph] " : "") << "Found "
+                  << (max_clique.is_optimal() ? "an optimal" : "a non-optimal")
+                  << " clique of size " << result.size() << " in process ("
+                  << max_clique.get_num_nodes() << " nodes)";
+        if(options.verbosity >= Options::Debug) {
+            std::cout << ": ";
+            for (Graph::VertexType clique_vertex: result) {
+                std::cout << clique_vertex << " ";
+            }
+        }
+        std::cout << "\n";
+    }
+    return result;
+}
+
 int IncSatGC::mycielsky_extension_lb(SubGraph H) const {
     //function to extend an initial subgraph to larger generalised mycielsky graph
     // returned is the size of H plus the number of successful extensions
@@ -475,8 +1015,7 @@ int IncSatGC::mycielsky_extension_lb(SubGraph H) const {
         matrix[elist[2 * i + 1]].set( elist[2 * i]);
     }
     //start algorithm with H being a clique, so initial k is the size of the clique
-    int initial_k = static_cast<int>(H.size());
-    int result_k = initial_k;
+    int result_k = static_cast<int>(H.size());
     Bitset W = Bitset(num_vertices);
     while (static_cast<int>(H.size()) < num_vertices){
         //initialize W=V and S_v = {v}
@@ -532,9 +1071,6 @@ int IncSatGC::mycielsky_extension_lb(SubGraph H) const {
             break;
         }
     }
-    if(options.verbosity >= Options::Verbose){
-        std::cout << "c Mycielsky: increased bound from initial " << initial_k << " to " << result_k << "\n";
-    }
     return result_k;
 }
 
@@ -559,6 +1095,27 @@ bool IncSatGC::reduced_graph() {
             break;
         }
 
+        if(options.extended_reductions) {
+            //twins are dominated by each other, removing them first is cheaper than the pairwise domination test
+            int num_removed_twins = graph.remove_twin_vertices();
+            stats.num_removed_twins += num_removed_twins;
+
+            //simplicial vertices give a clique bound and can be removed once the lower bound exceeds their degree
+            int simplicial_clique_size = 0;
+            int num_removed_simplicial = graph.remove_simplicial_vertices(lower_bound, simplicial_clique_size);
+            stats.num_removed_simplicial += num_removed_simplicial;
+            notify_clique_lb(simplicial_clique_size);
+
+            //fusing vertices along a crown of the complement graph keeps the chromatic number
+            int num_fused_crown = graph.fuse_crown_vertices();
+            stats.num_fused_vertices += num_fused_crown;
+
+            if(graph.ncount() <= lower_bound) {
+                notify_upper_bound(lower_bound);
+                break;
+            }
+        }
+
         //look for and remove dominated vertices
         int num_removed_dominated = graph.remove_dominated_vertices();
         stats.num_removed_dominated += num_removed_dominated;
@@ -568,6 +1125,25 @@ bool IncSatGC::reduced_graph() {
             notify_upper_bound(lower_bound);
             break;
         }
+
+        //clique-based fusion and edge addition are only valid when coloring with exactly |C| colors,
+        // so they are restricted to solving for a single k given by the size of the clique
+        if(options.extended_reductions and options.strategy == Options::SingleK
+            and static_cast<int>(clique.size()) == options.specific_num_colors.value()) {
+            //clique is given in original labels, map it to the reduced graph if it is still complete
+            std::vector<Graph::VertexType> remapping = graph.get_remapping();
+            std::vector<Graph::VertexType> reduced_clique;
+            for(Graph::VertexType v : clique) {
+                reduced_clique.push_back(remapping.empty() ? v : remapping[v]);
+            }
+            if(std::find(reduced_clique.begin(), reduced_clique.end(), Graph::UndefVertex) == reduced_clique.end()) {
+                int num_fused_clique = graph.fuse_clique_vertices(reduced_clique);
+                stats.num_fused_vertices += num_fused_clique;
+                int num_added_edges = graph.add_clique_edges(reduced_clique);
+                stats.num_added_edges += num_added_edges;
+                has_clique_based_reductions |= num_fused_clique > 0 or num_added_edges > 0;
+            }
+        }
     }
     //done with removing vertices, report change
     if(lower_bound == upper_bound) {
@@ -585,6 +1161,13 @@ bool IncSatGC::reduced_graph() {
             if(original_num_nodes != graph.ncount()){
                 std::cout << ". removed " << stats.num_removed_small_degree << " small degree and "
                           << stats.num_removed_dominated << " dominated vertices";
+                if(options.extended_reductions) {
+                    std::cout << ", " << stats.num_removed_twins << " twins and " << stats.num_removed_simplicial
+                              << " simplicial vertices, fused " << stats.num_fused_vertices << " vertices";
+                }
+            }
+            if(stats.num_added_edges) {
+                std::cout << ". added " << stats.num_added_edges << " edges";
             }
             std::cout << "\n";
         }
@@ -610,24 +1193,21 @@ void IncSatGC::preprocessing_clique_ordering() {
 void IncSatGC::preprocessing_initial_coloring() {
     stats.start_phase(Statistics::PreprocessingInitialColoring);
     graph_vertex_ordering.clear();
-    heuristic_coloring = graph.dsatur(graph_vertex_ordering, clique);
+    Graph::ColorMap dsatur_coloring = graph.dsatur_color_map(graph_vertex_ordering, clique);
+    heuristic_coloring = Graph::Graph::to_coloring(dsatur_coloring);
     // graph_vertex_ordering = graph.max_connected_degree_ordering(clique);
     //coloring uses fewer colors than lower bound because of graph reduction, set upper bound = lower bound
     if(static_cast<int>(heuristic_coloring.size()) < lower_bound){
         assert(has_removed_vertices_in_reduction);
-        assert(static_cast<int>(heuristic_coloring.size()) == lower_bound - 1);
-        // add empty color class for recovered vertex later on
-        heuristic_coloring.emplace_back();
+        assert(static_cast<int>(heuristic_coloring.size()) == lower_bound - 1 or options.extended_reductions);
+        // add empty color classes for recovered vertices later on
+        heuristic_coloring.resize(lower_bound);
     }
 
     if (static_cast<int>(heuristic_coloring.size()) < heuristic_bound) {
-        //transform and store heuristic coloring in current_best_coloring
-        current_best_coloring.resize(num_vertices, NoColor);
-        for (int cclass = 0; cclass < static_cast<int>(heuristic_coloring.size()); cclass++) {
-            for (auto v : heuristic_coloring[cclass]) {
-                current_best_coloring[v] = cclass;
-            }
-        }
+        //store heuristic coloring in current_best_coloring
+        current_best_coloring = dsatur_coloring;
+        assert(static_cast<int>(current_best_coloring.size()) == num_vertices);
         assert(std::count(current_best_coloring.begin(), current_best_coloring.end(), NoColor) == 0);
     }
     //Notify upper bound of new heuristic
@@ -639,6 +1219,255 @@ void IncSatGC::preprocessing_initial_coloring() {
     stats.end_phase(Statistics::PreprocessingInitialColoring);
 }
 
+void IncSatGC::preprocessing_local_search() {
+    if(options.local_search_time <= 0 or lower_bound >= upper_bound) {
+        return;
+    }
+    stats.start_phase(Statistics::PreprocessingInitialColoring);
+    assert(static_cast<int>(current_best_coloring.size()) == num_vertices);
+    //each thread starts from the best coloring found so far, drops one color and repairs the conflicts with tabu search
+    Graph::NeighborList neighbors = graph.get_neighbor_list();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(options.local_search_time));
+    ColorMap best_coloring = current_best_coloring;
+    std::atomic<int> best_num_colors = TabuCol::compact_colors(best_coloring);
+    int initial_num_colors = best_num_colors;
+    std::mutex best_mutex;
+    std::atomic<long long> num_iterations = 0;
+
+    auto local_search = [&](unsigned int seed) {
+        TabuCol tabu(neighbors, seed);
+        ColorMap coloring;
+        while (std::chrono::steady_clock::now() < deadline) {
+            int num_colors;
+            {
+                std::lock_guard<std::mutex> lock(best_mutex);
+                num_colors = best_num_colors;
+                coloring = best_coloring;
+            }
+            //colorings with fewer colors than the lower bound don't help for the reduced graph
+            if (num_colors - 1 < std::max(lower_bound, 1)) {
+                break;
+            }
+            TabuCol::drop_color(neighbors, coloring, num_colors);
+            if (tabu.find_coloring(coloring, num_colors - 1, deadline, best_num_colors)) {
+                int used_colors = TabuCol::compact_colors(coloring);
+                std::lock_guard<std::mutex> lock(best_mutex);
+                if (used_colors < best_num_colors) {
+                    best_num_colors = used_colors;
+                    best_coloring = coloring;
+                }
+            }
+            else if (num_colors - 1 <= 1) {
+                break; //a single color is decided right away by the edges, retrying can't help
+            }
+        }
+        num_iterations += tabu.get_num_iterations();
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < options.num_threads; ++i) {
+        threads.emplace_back(local_search, static_cast<unsigned int>(i));
+    }
+    local_search(0);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    if (best_num_colors < initial_num_colors) {
+        assert(is_valid_coloring(best_coloring));
+        current_best_coloring = best_coloring;
+        //vertices removed in reductions might need up to lower_bound colors
+        heuristic_coloring = Graph::Coloring(std::max(best_num_colors.load(), lower_bound));
+        for (int v = 0; v < num_vertices; ++v) {
+            heuristic_coloring[current_best_coloring[v]].insert(v);
+        }
+        notify_heuristic_ub(static_cast<int>(heuristic_coloring.size()));
+    }
+    if(options.verbosity >= Options::Verbose){
+        std::cout << "c Tabu search: upper bound of " << heuristic_bound << " after " << num_iterations
+                  << " iterations in " << options.num_threads << " thread(s)\n";
+    }
+    stats.end_phase(Statistics::PreprocessingInitialColoring);
+}
+
+void IncSatGC::preprocessing_core_lower_bound() {
+    if(lower_bound >= upper_bound) {
+        return;
+    }
+    stats.start_phase(Statistics::PreprocessingCore);
+    Graph::NeighborList neighbors = graph.get_neighbor_list();
+    //seed the core with the clique and the lower_bound vertices of highest degree
+    std::vector<Graph::VertexType> core;
+    std::vector<bool> in_core(num_vertices, false);
+    auto add_to_core = [&](Graph::VertexType v) {
+        if (not in_core[v]) {
+            in_core[v] = true;
+            core.push_back(v);
+        }
+    };
+    for (Graph::VertexType v : clique) {
+        add_to_core(v);
+    }
+    Graph::Permutation by_degree = graph.max_degree_ordering(neighbors);
+    for (int i = 0; i < num_vertices and static_cast<int>(core.size()) < static_cast<int>(clique.size()) + lower_bound; ++i) {
+        add_to_core(by_degree[i]);
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(options.core_time_limit));
+
+    //once the core is half of the graph, solving it is not much cheaper than solving the graph
+    while (lower_bound < upper_bound and 2 * static_cast<int>(core.size()) <= num_vertices) {
+        const int num_colors = lower_bound;
+        ColorMap core_coloring;
+        bool colorable;
+        try {
+            colorable = solve_core(neighbors, core, num_colors, core_coloring, deadline);
+        } catch (const SearchStopped &) {
+            if(options.verbosity >= Options::Verbose) {
+                std::cout << "c Core lower bound: time limit reached on core with " << core.size() << " vertices\n";
+            }
+            break;
+        }
+        if (not colorable) {
+            if(options.verbosity >= Options::Verbose) {
+                std::cout << "c Core lower bound: core with " << core.size() << " vertices is not "
+                          << num_colors << "-colorable\n";
+            }
+            notify_lower_bound(num_colors + 1);
+            continue;
+        }
+        //try to color the rest of the graph with the same colors
+        ColorMap colors(num_vertices, NoColor);
+        for (int i = 0; i < static_cast<int>(core.size()); ++i) {
+            colors[core[i]] = core_coloring[i];
+        }
+        std::vector<Graph::VertexType> conflicts = extend_core_coloring(neighbors, colors, num_colors);
+        if (conflicts.empty()) {
+            assert(is_valid_coloring(colors));
+            current_best_coloring = colors;
+            heuristic_coloring = Graph::Graph::to_coloring(colors);
+            heuristic_coloring.resize(num_colors);
+            notify_heuristic_ub(num_colors);
+            if(options.verbosity >= Options::Verbose) {
+                std::cout << "c Core lower bound: coloring of core with " << core.size() << " vertices extends to "
+                          << num_colors << "-coloring of the graph\n";
+            }
+            break;
+        }
+        if(options.verbosity >= Options::Debug) {
+            std::cout << "c Core lower bound: core with " << core.size() << " vertices grows by "
+                      << conflicts.size() << " conflicting vertices\n";
+        }
+        for (Graph::VertexType v : conflicts) {
+            add_to_core(v);
+        }
+    }
+    stats.core_size = static_cast<int>(core.size());
+    stats.end_phase(Statistics::PreprocessingCore);
+}
+
+bool IncSatGC::solve_core(const Graph::NeighborList &neighbors, const std::vector<Graph::VertexType> &core,
+                          int num_colors, ColorMap &core_coloring, std::chrono::steady_clock::time_point deadline) {
+    //cores that are not larger than k are colored by giving every vertex its own color
+    if (static_cast<int>(core.size()) <= num_colors) {
+        core_coloring.resize(core.size());
+        std::iota(core_coloring.begin(), core_coloring.end(), 0);
+        return true;
+    }
+    //induced subgraph on the core, vertex core[i] becomes i
+    std::vector<int> position(num_vertices, -1);
+    for (int i = 0; i < static_cast<int>(core.size()); ++i) {
+        position[core[i]] = i;
+    }
+    std::vector<Graph::VertexType> edges;
+    for (int i = 0; i < static_cast<int>(core.size()); ++i) {
+        for (Graph::VertexType w : neighbors[core[i]]) {
+            if (position[w] > i) {
+                edges.push_back(i);
+                edges.push_back(position[w]);
+            }
+        }
+    }
+    Graph::Graph core_graph(static_cast<Graph::VertexType>(core.size()),
+                            static_cast<Graph::VertexType>(edges.size() / 2), std::move(edges));
+
+    Options core_options = options;
+    core_options.verbosity = Options::Quiet;
+    core_options.encoding = Options::ZykovPropagator;
+    core_options.strategy = Options::SingleK;
+    core_options.specific_num_colors = num_colors;
+    core_options.disable_preprocessing = true;
+    core_options.use_clique_in_ordering = false;
+    core_options.reduce_graph = false;
+    core_options.decompose_graph = false;
+    core_options.core_lower_bound = false;
+    core_options.write_cnf_only = false;
+    core_options.original_paper_configuration = false;
+    core_options.use_clique_explanation_clauses = true;
+    core_options.stats_csvfile.clear();
+    core_options.coloringfilepath.clear();
+    core_options.filename = options.filename + "_core";
+    //the terminator stops the SAT call at the deadline, its bounds never meet
+    SharedBounds budget(0, num_vertices + 1, {});
+    budget.deadline = deadline;
+    IncSatGC core_instance(core_graph, core_options, true);
+    for (Graph::VertexType v : clique) {
+        core_instance.clique.push_back(position[v]);
+    }
+    core_instance.notify_lower_bound(static_cast<int>(clique.size()));
+    core_instance.shared_bounds = &budget;
+    core_instance.reset_SAT_solver();
+    bool colorable = core_instance.compute_chromatic_number() == 1;
+    stats.num_solved_cores++;
+    if (colorable) {
+        core_coloring = core_instance.current_best_coloring;
+        assert(core_instance.is_valid_coloring(core_coloring));
+    }
+    return colorable;
+}
+
+std::vector<Graph::VertexType> IncSatGC::extend_core_coloring(const Graph::NeighborList &neighbors, ColorMap &colors,
+                                                              int num_colors) const {
+    //dsatur restricted to num_colors colors on the uncolored vertices, those without a free color are the conflicts
+    std::vector<Bitset> forbidden(num_vertices, Bitset(num_colors));
+    std::vector<bool> done(num_vertices, false);
+    int num_done = 0;
+    auto forbid_for_neighbors = [&](Graph::VertexType v) {
+        for (Graph::VertexType w : neighbors[v]) {
+            forbidden[w].set(colors[v]);
+        }
+    };
+    for (Graph::VertexType v = 0; v < num_vertices; ++v) {
+        if (colors[v] != NoColor) {
+            done[v] = true;
+            num_done++;
+            forbid_for_neighbors(v);
+        }
+    }
+    std::vector<Graph::VertexType> conflicts;
+    while (num_done < num_vertices) {
+        Graph::VertexType next = -1;
+        for (Graph::VertexType v = 0; v < num_vertices; ++v) {
+            if (done[v]) {
+                continue;
+            }
+            if (next < 0 or forbidden[v].count() > forbidden[next].count()
+                or (forbidden[v].count() == forbidden[next].count() and neighbors[v].size() > neighbors[next].size())) {
+                next = v;
+            }
+        }
+        done[next] = true;
+        num_done++;
+        if (forbidden[next].all()) {
+            conflicts.push_back(next);
+            continue;
+        }
+        colors[next] = static_cast<int>((~forbidden[next]).find_first());
+        forbid_for_neighbors(next);
+    }
+    return conflicts;
+}
+
 void IncSatGC::preprocessing_reductions() {
     stats.start_phase(Statistics::PreprocessingReductions);
     has_removed_vertices_in_reduction = reduced_graph();
@@ -689,7 +1518,7 @@ void IncSatGC::preprocessing_mycielsky_bound() {
 }
 
 
-int IncSatGC::external_get_fractional() {
+int IncSatGC::external_get_fractional(bool write_graph) {
     std::vector<Graph::VertexType> CliSAT_clique;
     namespace bp = boost::process::v1;
 
@@ -705,14 +1534,14 @@ int IncSatGC::external_get_fractional() {
 #endif
 
     std::string tmp_name;
-    if(has_removed_vertices_in_reduction){
+    if(write_graph){
         //write current problem graph to file, so we can run EC
         tmp_name = "tmp_reduced_" + std::string(options.filename);
         graph.write_dimacs(tmp_name);
     }
 
     std::vector<std::string> args(2);
-    args[0] = (has_removed_vertices_in_reduction ? tmp_name : options.filepath);
+    args[0] = (write_graph ? tmp_name : options.filepath);
     args[1] = "-s 0";
 
     std::string cmd_output;
@@ -723,17 +1552,23 @@ int IncSatGC::external_get_fractional() {
     bp::child c(EC_path.string(), args, bp::std_out > out_stream);
 
     auto TIMEOUT = std::chrono::seconds(initial_fractional_timeout);
-    bool finished = c.wait_for(TIMEOUT);
+    //wait in short slices, so the process can be stopped as soon as preprocessing found the chromatic number
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    bool finished = false;
+    while (not finished and not cancel_preprocessing and std::chrono::steady_clock::now() < deadline) {
+        finished = c.wait_for(std::chrono::milliseconds(20));
+    }
 
     //add child process time to stats
+    //(if it runs concurrently to CliSAT, the child time of both processes can't be separated)
     stats.add_fractional_time(Statistics::childCpuTime() - start);
 
     if (not finished) {
         c.terminate();
-        if(has_removed_vertices_in_reduction){
+        if(write_graph){
             std::filesystem::remove(tmp_name);
         }
-        flag_fractional_timed_out = true;
+        flag_fractional_timed_out = not cancel_preprocessing;
         return 0; //ec did not produce a lower bound
     }
     else {
@@ -754,7 +1589,7 @@ int IncSatGC::external_get_fractional() {
         throw std::runtime_error("CliSAT finished but did not print 'Opt Colors:' line");
     }
 
-    if(has_removed_vertices_in_reduction){
+    if(write_graph){
         //delete written temporary graph
         std::filesystem::remove(tmp_name);
     }
@@ -779,7 +1614,12 @@ void IncSatGC::notify_already_used_fewer_colors(const int num_colors) {
     collect_bound_information(num_colors, true);
 }
 
-void IncSatGC::notify_lower_bound(const int num_colors) {
+void IncSatGC::notify_lower_bound(int num_colors) {
+    //the graph after clique-based reductions is only k-colorable iff the original one is, larger bounds of it
+    // don't hold for the original graph
+    if(has_clique_based_reductions) {
+        num_colors = std::min(num_colors, options.specific_num_colors.value() + 1);
+    }
     if(lower_bound < num_colors){
         lower_bound = num_colors;
         stats.lower_bound = num_colors;
@@ -796,6 +1636,9 @@ void IncSatGC::notify_clique_lb(const int num_colors) {
 }
 
 void IncSatGC::notify_mycielsky_lb(const int num_colors) {
+    if(options.verbosity >= Options::Verbose){
+        std::cout << "c Mycielsky: extension of a single vertex gives lower bound " << num_colors << "\n";
+    }
     if(mc_lower_bound < num_colors){
         mc_lower_bound = num_colors;
         stats.mc_lower_bound = num_colors;
@@ -936,8 +1779,9 @@ ColorMap IncSatGC::obtain_coloring_from_direct_encoding(int num_colors) const {
     //same method for direct and partial order encoding, the assignment variables are the same
     ColorMap colors(num_vertices, NoColor);
     Model model = get_model();
-    assert(static_cast<int>(model.size()) == num_colors * num_vertices);
-    if(options.encoding == Options::AssignmentEncoding) {
+    //incremental bottom-up adds guard variables after the encoding
+    assert(static_cast<int>(model.size()) >= num_colors * num_vertices);
+    if(options.encoding == Options::AssignmentEncoding or options.encoding == Options::AssignmentPropagator) {
         //have k|V| variables x_v,j  for vertices 0<=v<=num_vertices-1 and color j
         //map x_v,j to variable with index k*v + j, first index is 0
         for (int v = 0; v < num_vertices; v++) {
@@ -998,6 +1842,16 @@ int IncSatGC::get_num_colors_from_model() const {
 }
 
 
+ColorMap IncSatGC::obtain_zykov_coloring() {
+    //if the propagator stopped the solver, there is no model but the coloring it found
+    if(not search_coloring.empty()) {
+        ColorMap colors = std::move(search_coloring);
+        search_coloring.clear();
+        return colors;
+    }
+    return obtain_coloring_from_model();
+}
+
 ColorMap IncSatGC::obtain_coloring_from_model() const {
     //look at all vertices and see if it has the same color as some previously used vertex
     //if yes, reduce number of needed colors, otherwise add it and all same colored vertices to the list
@@ -1025,22 +1879,7 @@ ColorMap IncSatGC::obtain_coloring_from_model() const {
 
 
 
-void IncSatGC::write_optimal_coloring() {
-    assert(not options.coloringfilepath.empty());
-    //write found coloring to file
-    std::string out_name = options.coloringfilepath;
-    std::ofstream out_file = std::ofstream(out_name);
-    if(!out_file.is_open()){
-        std::cout << "Error: could not open file to write coloring to\n";
-        return;
-    }
-    //coloring file header
-    out_file << "c Coloring of graph " << options.filename << "\n"
-             << "c Syntax: \n"
-             << "c      p <problem name> <number of colors>\n"
-             << "c      s <list of integers (= a color class)>\n";
-    out_file << "p " << options.filename << " " << upper_bound << "\n";
-
+Graph::Coloring IncSatGC::recover_optimal_coloring() {
     //convert colormap to collection of color classes
     Graph::Coloring coloring(upper_bound);
     if(not solved_in_preprocessing) {
@@ -1108,18 +1947,31 @@ void IncSatGC::write_optimal_coloring() {
         }
 
         //now undo the reductions and get the set of recovered vertices in order of last removed to first
-        std::vector<Graph::VertexType> recovered_vertices = graph.recover_reductions();
+        std::vector<Graph::VertexType> fused_with;
+        std::vector<std::vector<Graph::VertexType>> removal_neighbors;
+        std::vector<Graph::VertexType> recovered_vertices = graph.recover_reductions(fused_with, removal_neighbors);
 
         //still need to find a color for the vertices recovered in reduction,
-        // possible to color them without an additional color though
-        auto neighborlist = graph.get_neighbor_list();
-        for (Graph::VertexType uncolored : recovered_vertices) {
+        // possible to color them without an additional color though.
+        //each vertex is colored against the neighbors it had when it was removed, since the vertices removed after it
+        // only avoided the colors of its fused partner or the added edges and not of its original neighbors
+        for (int i = 0; i < static_cast<int>(recovered_vertices.size()); ++i) {
+            Graph::VertexType uncolored = recovered_vertices[i];
+            if(fused_with[i] != Graph::UndefVertex) {
+                //fused vertices take the color of the vertex they were fused into, which is already colored and
+                // inherited all neighbors of the fused vertex
+                auto cc = std::find_if(coloring.begin(), coloring.end(),
+                    [&](const Graph::ColorClass &cclass){ return cclass.count(fused_with[i]); });
+                assert(cc != coloring.end());
+                cc->insert(uncolored);
+                continue;
+            }
             bool assigned_color = false;
             for (Graph::ColorClass &cc : coloring) {
                 if(not cc.count(uncolored)){
                     //also check that no adjacent vertex is in colorclass
                     bool can_be_inserted = true;
-                    for (Graph::VertexType nb : neighborlist[uncolored]) {
+                    for (Graph::VertexType nb : removal_neighbors[i]) {
                         if(cc.count(nb)){
                             can_be_inserted = false;
                             break;
@@ -1140,7 +1992,26 @@ void IncSatGC::write_optimal_coloring() {
     if(not is_valid_coloring(coloring)) {
         throw std::runtime_error("Optimal coloring recovered after reductions was not valid.");
     }
+    return coloring;
+}
 
+void IncSatGC::write_optimal_coloring() {
+    assert(not options.coloringfilepath.empty());
+    //write found coloring to file
+    std::string out_name = options.coloringfilepath;
+    std::ofstream out_file = std::ofstream(out_name);
+    if(!out_file.is_open()){
+        std::cout << "Error: could not open file to write coloring to\n";
+        return;
+    }
+    //coloring file header
+    out_file << "c Coloring of graph " << options.filename << "\n"
+             << "c Syntax: \n"
+             << "c      p <problem name> <number of colors>\n"
+             << "c      s <list of integers (= a color class)>\n";
+    out_file << "p " << options.filename << " " << upper_bound << "\n";
+
+    Graph::Coloring coloring = recover_optimal_coloring();
 
     //finally write color classes
     for (int i = 0; i < upper_bound; ++i) {
@@ -1155,19 +2026,26 @@ void IncSatGC::write_optimal_coloring() {
 
 
 void IncSatGC::build_direct_encoding(int num_colors) {
+    direct_encoding_num_colors = num_colors;
     if (options.encoding == Options::AssignmentEncoding){
         build_assignment_encoding(num_colors);
     }
     else if(options.encoding == Options::PartialOrderEncoding){
         build_partial_order_encoding(num_colors);
     }
+    else if(options.encoding == Options::AssignmentPropagator){
+        //only the at-least-one clauses are built, the propagator handles the rest
+        build_assignment_encoding(num_colors);
+        init_assignment_propagator(num_colors);
+    }
     else {
         throw std::runtime_error("Invalid encoding option in build_direct_encoding");
     }
 }
 
 bool IncSatGC::direct_encoding_single_k() {
-    assert(options.encoding == Options::AssignmentEncoding or options.encoding == Options::PartialOrderEncoding);
+    assert(options.encoding == Options::AssignmentEncoding or options.encoding == Options::PartialOrderEncoding
+           or options.encoding == Options::AssignmentPropagator);
     if (not options.specific_num_colors.has_value()) {
         throw std::runtime_error("Chose single k as search strategy but no k was given.");
     }
@@ -1201,7 +2079,8 @@ bool IncSatGC::direct_encoding_single_k() {
 }
 
 int IncSatGC::direct_encoding_top_down() {
-    assert(options.encoding == Options::AssignmentEncoding or options.encoding == Options::PartialOrderEncoding);
+    assert(options.encoding == Options::AssignmentEncoding or options.encoding == Options::PartialOrderEncoding
+           or options.encoding == Options::AssignmentPropagator);
     if(options.specific_num_colors.has_value()){
         //a number of colors was given, use that as starting point bound in top-down approach
         notify_upper_bound(options.specific_num_colors.value() + 1);
@@ -1211,8 +2090,13 @@ int IncSatGC::direct_encoding_top_down() {
     int full_num_colors = num_colors;
     build_direct_encoding(full_num_colors);
     print_sat_size();
+    share_bounds();
     //start top down solving
     while(lower_bound != upper_bound){
+        if (assignment_propagator) {
+            //colors num_colors,... are fixed to false by unit clauses
+            assignment_propagator->update_num_colors(num_colors, 0);
+        }
         bool res = run_solver();
         notify_new_bound(res, num_colors);
         if (res){
@@ -1241,6 +2125,7 @@ int IncSatGC::direct_encoding_top_down() {
         else {//not satisfiable. chromatic number is current upper bound, stop loop
             notify_lower_bound(upper_bound);
         }
+        share_bounds();
     }
     //chromatic number is lower_bound=upper_bound
     stats.solved = true;
@@ -1249,7 +2134,7 @@ int IncSatGC::direct_encoding_top_down() {
 
 void IncSatGC::direct_encoding_top_down_fix_variables(const int full_num_colors, const int colors) {
     //fix the assignment variables x_v,colors-1 to false,
-    if(options.encoding == Options::AssignmentEncoding) {
+    if(options.encoding == Options::AssignmentEncoding or options.encoding == Options::AssignmentPropagator) {
         for (int v = 0; v < num_vertices; ++v) {
             solver->addClause(mkLit(full_num_colors * v + (colors - 1), true));
         }
@@ -1264,25 +2149,47 @@ void IncSatGC::direct_encoding_top_down_fix_variables(const int full_num_colors,
 }
 
 int IncSatGC::direct_encoding_bottom_up() {
-    assert(options.encoding == Options::AssignmentEncoding or options.encoding == Options::PartialOrderEncoding);
+    assert(options.encoding == Options::AssignmentEncoding or options.encoding == Options::PartialOrderEncoding
+           or options.encoding == Options::AssignmentPropagator);
     if(options.specific_num_colors.has_value()){
         //a number of colors was given, use that as starting point bound in bottom-up approach
         notify_lower_bound(options.specific_num_colors.value());
     }
     int num_colors = lower_bound;
+    const bool incremental = not options.non_incremental_solving;
+    if (incremental and lower_bound != upper_bound) {
+        //build the encoding once for the largest number of colors that can still be needed,
+        //each k is then solved under the assumption of the guard that disables colors k and above
+        build_direct_encoding(upper_bound - 1);
+        add_direct_encoding_color_guards(upper_bound - 1);
+        print_sat_size();
+    }
+    share_bounds();
     //start bottom up solving
     while ( lower_bound != upper_bound ) {
-        //build and solve direct encoding for each k, there is no incremental procedure between different colors
-        reset_SAT_solver();
-        build_direct_encoding(num_colors);
-        print_sat_size();
+        if (incremental) {
+            encoder_assumptions.clear();
+            if (num_colors < direct_encoding_num_colors) {
+                encoder_assumptions.push(mkLit(direct_encoding_first_guard + num_colors - 1, false));
+            }
+            if (assignment_propagator) {
+                assignment_propagator->update_num_colors(num_colors, encoder_assumptions.size() ?
+                                                         direct_encoding_first_guard + num_colors : 0);
+            }
+        }
+        else {
+            //build and solve direct encoding for each k from scratch
+            reset_SAT_solver();
+            build_direct_encoding(num_colors);
+            print_sat_size();
+        }
         bool res = run_solver();
         notify_new_bound(res, num_colors);
         if (res){
             //found a k-coloring, became satisfiable
             notify_upper_bound(num_colors); //num_colors == lower_bound == first satisfiable k
             //update best found coloring (will be an optimal one)
-            current_best_coloring = obtain_coloring_from_direct_encoding(num_colors);
+            current_best_coloring = obtain_coloring_from_direct_encoding(direct_encoding_num_colors);
             assert(*std::max_element(current_best_coloring.begin(), current_best_coloring.end()) + 1 == num_colors);
             assert(lower_bound == upper_bound);
         }
@@ -1290,12 +2197,96 @@ int IncSatGC::direct_encoding_bottom_up() {
             notify_lower_bound(num_colors + 1); //+1 because num_colors was UNSAT
             num_colors++;
         }
+        share_bounds();
+    }
+    encoder_assumptions.clear();
+    //chromatic number is lower_bound=upper_bound
+    stats.solved = true;
+    return upper_bound;
+}
+
+int IncSatGC::direct_encoding_bisection() {
+    assert(options.encoding == Options::AssignmentEncoding or options.encoding == Options::PartialOrderEncoding
+           or options.encoding == Options::AssignmentPropagator);
+    //build the encoding once for upper_bound - 1 colors, every k is then solved under the assumption of its guard
+    if (lower_bound != upper_bound) {
+        build_direct_encoding(upper_bound - 1);
+        add_direct_encoding_color_guards(upper_bound - 1);
+        print_sat_size();
+    }
+    int gallop_step = 1;
+    while ( lower_bound != upper_bound ) {
+        int num_colors = bisection_num_colors(gallop_step);
+        encoder_assumptions.clear();
+        if (num_colors < direct_encoding_num_colors) {
+            encoder_assumptions.push(mkLit(direct_encoding_first_guard + num_colors - 1, false));
+        }
+        if (assignment_propagator) {
+            assignment_propagator->update_num_colors(num_colors, encoder_assumptions.size() ?
+                                                     direct_encoding_first_guard + num_colors : 0);
+        }
+        bool res = run_solver();
+        notify_new_bound(res, num_colors);
+        if (res){
+            notify_upper_bound(num_colors);
+            current_best_coloring = obtain_coloring_from_direct_encoding(direct_encoding_num_colors);
+            int num_colors_used = *std::max_element(current_best_coloring.begin(), current_best_coloring.end()) + 1;
+            if(num_colors_used < num_colors){
+                notify_upper_bound(num_colors_used);
+                notify_already_used_fewer_colors(num_colors_used);
+            }
+            gallop_step = std::max(1, gallop_step / 2);
+        }
+        else {
+            notify_lower_bound(num_colors + 1);
+            gallop_step *= 2;
+        }
     }
+    encoder_assumptions.clear();
     //chromatic number is lower_bound=upper_bound
     stats.solved = true;
     return upper_bound;
 }
 
+int IncSatGC::bisection_num_colors(const int gallop_step) const {
+    //gallop up from the lower bound, doubling the step after each unsatisfiable k, but never beyond the middle of the
+    //open range [lower_bound, upper_bound - 1]. once the range has at most two values this is a unit step from below
+    assert(lower_bound < upper_bound and gallop_step >= 1);
+    int middle = lower_bound + (upper_bound - 1 - lower_bound) / 2;
+    return std::min(lower_bound + gallop_step - 1, middle);
+}
+
+void IncSatGC::add_direct_encoding_color_guards(const int num_colors) {
+    //guard g_c for 1 <= c < num_colors forbids the colors c,...,num_colors-1, so under the assumption g_k
+    //the encoding only has k colors left. the guards are the variables after those of the encoding
+    direct_encoding_first_guard = get_num_vars();
+    add_vars(num_colors - 1);
+    auto guard = [this](int c) { return direct_encoding_first_guard + c - 1; };
+    assert(not tmp_clause.size());
+    for (int c = 1; c < num_colors; ++c) {
+        //g_c -> g_c+1, colors above c are forbidden as well
+        if (c + 1 < num_colors) {
+            tmp_clause.push(mkLit(guard(c), true));
+            tmp_clause.push(mkLit(guard(c + 1), false));
+            solver->addClause(tmp_clause);
+            tmp_clause.clear();
+        }
+        for (int v = 0; v < num_vertices; ++v) {
+            tmp_clause.push(mkLit(guard(c), true));
+            if (options.encoding != Options::PartialOrderEncoding) {
+                //g_c -> -x_v,c
+                tmp_clause.push(mkLit(num_colors * v + c, true));
+            }
+            else {
+                //g_c -> -y_v,c-1, i.e. v has color at most c-1
+                tmp_clause.push(mkLit(num_colors * v + (c - 1), true));
+            }
+            solver->addClause(tmp_clause);
+            tmp_clause.clear();
+        }
+    }
+}
+
 int IncSatGC::do_assignment_encoding() {
     switch (options.strategy) {
         case Options::SingleK:
@@ -1307,6 +2298,9 @@ int IncSatGC::do_assignment_encoding() {
         case Options::BottomUp:
             assignment_encoding_bottom_up();
             break;
+        case Options::Bisection:
+            direct_encoding_bisection();
+            break;
         default:
             throw std::runtime_error("Invalid option for search strategy.");
     }
@@ -1347,9 +2341,12 @@ void IncSatGC::build_assignment_encoding(const int num_colors) {
         tmp_clause.clear();
     }
 
+    //the assignment propagator enforces the different-colors and at-most-one constraints without clauses
+    const bool materialize_constraints = options.encoding == Options::AssignmentEncoding;
+
     //add different-colors constraint
     //for edge (u,v) and color c, ensure that one of x_u,c or x_v,c is false
-    std::vector<Graph::VertexType> edge_list = graph.elist();
+    std::vector<Graph::VertexType> edge_list = materialize_constraints ? graph.elist() : std::vector<Graph::VertexType>();
     for (int c = 0; c < num_colors; c++) {
         for (int index = 0; 2 * index < static_cast<int>(edge_list.size()); index++) {
             tmp_clause.push(mkLit(num_colors * (edge_list[2 * index]) + c, true));
@@ -1359,17 +2356,14 @@ void IncSatGC::build_assignment_encoding(const int num_colors) {
         }
     }
 
-    //optionally add at-most-one color constraint (-x_v,i or -x_v,j)
-    if(options.assignment_encoding_amo) {
+    //optionally add at-most-one color constraint on x_v,0,...,x_v,k-1
+    if(options.assignment_encoding_amo and materialize_constraints) {
+        std::vector<Lit> vertex_literals(num_colors);
         for (int v = 0; v < num_vertices; v++) {
-            for (int i = 0; i < num_colors; i++) {
-                for (int j = i + 1; j < num_colors; j++) {
-                    tmp_clause.push(mkLit(num_colors * v + i, true));
-                    tmp_clause.push(mkLit(num_colors * v + j, true));
-                    solver->addClause(tmp_clause);
-                    tmp_clause.clear();
-                }
+            for (int c = 0; c < num_colors; c++) {
+                vertex_literals[c] = mkLit(num_colors * v + c, false);
             }
+            add_at_most_one(vertex_literals);
         }
     }
 
@@ -1384,10 +2378,176 @@ void IncSatGC::build_assignment_encoding(const int num_colors) {
             }
         }
     }
-
-
-    //could also consider symmetry breaking clauses as in Van Gelder or Van Hoeve paper
-    stats.end_phase(Statistics::BuildEncoding);
+
+    if (options.color_ordering) {
+        add_color_ordering(num_colors);
+    }
+    stats.end_phase(Statistics::BuildEncoding);
+}
+
+void IncSatGC::add_at_most_one(const std::vector<Lit> &literals) {
+    switch (options.amo_encoding) {
+        case Options::PairwiseAMO:
+            add_pairwise_amo(literals);
+            break;
+        case Options::SequentialAMO:
+            add_sequential_amo(literals);
+            break;
+        case Options::ProductAMO:
+            add_product_amo(literals);
+            break;
+        case Options::CommanderAMO:
+            add_commander_amo(literals);
+            break;
+        default:
+            throw std::runtime_error("Invalid option for at-most-one encoding.");
+    }
+}
+
+void IncSatGC::add_pairwise_amo(const std::vector<Lit> &literals) {
+    //(-l_i or -l_j) for all pairs
+    for (std::size_t i = 0; i < literals.size(); i++) {
+        for (std::size_t j = i + 1; j < literals.size(); j++) {
+            solver->addClause(~literals[i], ~literals[j]);
+        }
+    }
+}
+
+void IncSatGC::add_sequential_amo(const std::vector<Lit> &literals) {
+    //sequential counter of Sinz, s_i is true if one of l_0,...,l_i is true, n-1 new variables and 3n clauses
+    const int n = static_cast<int>(literals.size());
+    if (n <= 1) {
+        return;
+    }
+    const int first_counter = get_num_vars();
+    add_vars(n - 1);
+    auto counter = [first_counter](int i) { return mkLit(first_counter + i, false); };
+    for (int i = 0; i < n; i++) {
+        if (i < n - 1) {
+            //l_i -> s_i
+            solver->addClause(~literals[i], counter(i));
+        }
+        if (i > 0) {
+            //s_i-1 -> -l_i, and s_i-1 -> s_i
+            solver->addClause(~counter(i - 1), ~literals[i]);
+            if (i < n - 1) {
+                solver->addClause(~counter(i - 1), counter(i));
+            }
+        }
+    }
+}
+
+void IncSatGC::add_product_amo(const std::vector<Lit> &literals) {
+    //product encoding of Chen, the literals are put on a p x q grid and l_i implies its row and column variable,
+    //then at most one row and one column can be used. about 2n + O(sqrt n) clauses
+    const int n = static_cast<int>(literals.size());
+    if (n <= 4) {
+        add_pairwise_amo(literals);
+        return;
+    }
+    const int p = static_cast<int>(std::ceil(std::sqrt(n)));
+    const int q = (n + p - 1) / p;
+    const int first_row = get_num_vars();
+    add_vars(p + q);
+    std::vector<Lit> rows(p), columns(q);
+    for (int r = 0; r < p; r++) {
+        rows[r] = mkLit(first_row + r, false);
+    }
+    for (int c = 0; c < q; c++) {
+        columns[c] = mkLit(first_row + p + c, false);
+    }
+    for (int i = 0; i < n; i++) {
+        solver->addClause(~literals[i], rows[i / q]);
+        solver->addClause(~literals[i], columns[i % q]);
+    }
+    add_product_amo(rows);
+    add_product_amo(columns);
+}
+
+void IncSatGC::add_commander_amo(const std::vector<Lit> &literals) {
+    //commander encoding of Klieber and Kwon, the literals are split into groups of three with pairwise constraints,
+    //each group has a commander that is implied by its literals and at most one commander is true
+    const int n = static_cast<int>(literals.size());
+    if (n <= 4) {
+        add_pairwise_amo(literals);
+        return;
+    }
+    constexpr int group_size = 3;
+    const int num_groups = (n + group_size - 1) / group_size;
+    const int first_commander = get_num_vars();
+    add_vars(num_groups);
+    std::vector<Lit> commanders(num_groups);
+    for (int g = 0; g < num_groups; g++) {
+        commanders[g] = mkLit(first_commander + g, false);
+        std::vector<Lit> group(literals.begin() + g * group_size,
+                               literals.begin() + std::min(n, (g + 1) * group_size));
+        add_pairwise_amo(group);
+        for (Lit lit : group) {
+            solver->addClause(~lit, commanders[g]);
+        }
+    }
+    add_commander_amo(commanders);
+}
+
+std::vector<int> IncSatGC::color_ordering_vertex_order() const {
+    std::vector<int> order;
+    order.reserve(num_vertices);
+    std::vector<bool> in_clique(num_vertices, false);
+    if (not options.disable_preprocessing or options.encoding == Options::PartialOrderEncoding) {
+        //the clique vertices are fixed to the colors 0,1,... by the encodings
+        for (int v : clique) {
+            order.push_back(v);
+            in_clique[v] = true;
+        }
+    }
+    for (int v = 0; v < num_vertices; v++) {
+        if (not in_clique[v]) {
+            order.push_back(v);
+        }
+    }
+    return order;
+}
+
+void IncSatGC::add_color_ordering(const int num_colors) {
+    //symmetry breaking as in Van Gelder: the vertices are ordered with the clique first, in the order of the colors
+    //it is fixed to, then the other vertices. a vertex can only get color c > 0 if an earlier vertex has color c - 1.
+    //in both encodings, l_v,c (x_v,c or y_v,c, index k*v+c) implies that an earlier vertex has l_u,c-1, which also
+    //orders the partial order encoding since y_v,c means that v has a color larger than c.
+    //m_i,c is true only if one of the first i+1 vertices of the order has l_u,c, (n-1)(k-1) new variables
+    std::vector<int> order = color_ordering_vertex_order();
+    auto literal = [num_colors](int v, int c) { return mkLit(num_colors * v + c, false); };
+    if (num_vertices == 0 or num_colors == 1) {
+        return;
+    }
+    const int first_prefix = get_num_vars();
+    add_vars((num_vertices - 1) * (num_colors - 1));
+    auto prefix = [first_prefix, num_colors](int i, int c) { return mkLit(first_prefix + (num_colors - 1) * i + c, false); };
+
+    //the first vertex can only have color 0
+    for (int c = 1; c < num_colors; c++) {
+        solver->addClause(~literal(order[0], c));
+    }
+    if (options.encoding == Options::PartialOrderEncoding) {
+        solver->addClause(~literal(order[0], 0));
+    }
+    for (int i = 0; i < num_vertices - 1; i++) {
+        for (int c = 0; c < num_colors - 1; c++) {
+            //m_i,c -> m_i-1,c or l_order[i],c
+            tmp_clause.push(~prefix(i, c));
+            if (i > 0) {
+                tmp_clause.push(prefix(i - 1, c));
+            }
+            tmp_clause.push(literal(order[i], c));
+            solver->addClause(tmp_clause);
+            tmp_clause.clear();
+        }
+    }
+    for (int i = 1; i < num_vertices; i++) {
+        for (int c = 1; c < num_colors; c++) {
+            //l_order[i],c -> m_i-1,c-1
+            solver->addClause(~literal(order[i], c), prefix(i - 1, c - 1));
+        }
+    }
 }
 
 
@@ -1459,6 +2619,10 @@ void IncSatGC::build_partial_order_encoding(const int num_colors) {
             solver->addClause(mkLit( num_colors * i + i, true));
         }
     }
+
+    if (options.color_ordering) {
+        add_color_ordering(num_colors);
+    }
     stats.end_phase(Statistics::BuildEncoding);
 }
 
@@ -1486,6 +2650,9 @@ int IncSatGC::do_partial_order_encoding() {
         case Options::BottomUp:
             partial_order_encoding_bottom_up();
             break;
+        case Options::Bisection:
+            direct_encoding_bisection();
+            break;
         default:
             throw std::runtime_error("Invalid option for search strategy.");
     }
@@ -1508,116 +2675,102 @@ int IncSatGC::partial_order_encoding_bottom_up() {
 void IncSatGC::write_full_maxsat_encoding() {
     stats.start_phase(Statistics::BuildEncoding);
     //write wcnf to file
-    std::string out_name = options.filename + "_MaxSAT.wcnf";
-    wcnf = std::ofstream(out_name);
-    if(!wcnf.is_open()){
-        throw std::runtime_error("Could not open file to write wcnf.");
-    }
+    std::string out_name = options.filename + "_MaxSAT.wcnf" + (options.compress_output ? ".gz" : "");
+    ClauseWriter wcnf(out_name, options.compress_output);
     //initialise indices of s_ij and c_j in member fields
     initialise_variable_indices(1);//wncf format starts with 1
 
     //initialising and indices done, start writing formula
-    wcnf << "c wcnf formula that uses the zykov encoding and all transitivity constraints \n"
-         << "c to compute the chromatic number with this MaxSAT formula.\n";
+    wcnf.comment("wcnf formula that uses the zykov encoding and all transitivity constraints");
+    wcnf.comment("to compute the chromatic number with this MaxSAT formula.");
     //compute header, "p wcnf nbvars nbclauses top" where top marks hard clauses
+    //the clauses are counted beforehand: for every vertex j there is one transitivity clause for each pair of its
+    // non-neighbours, and the c_j definition has one clause per non-neighbour i<j and one more clause
     int nbvars = c_indices.back();
-    int nbclauses = -1; //can't say yet how many clauses, seems to be fine for solvers though
+    long long nbclauses = num_vertices - 1; //soft clauses
+    for (int j = 0; j < num_vertices; ++j) {
+        long long non_neighbours = static_cast<long long>(complement_graph_adjacency[j].size());
+        nbclauses += non_neighbours * (non_neighbours - 1) / 2;
+        if (j > 0) {
+            nbclauses += 1 + std::count_if(complement_graph_adjacency[j].begin(), complement_graph_adjacency[j].end(),
+                                           [j](int i) { return i < j; });
+        }
+    }
     int top = graph.ncount();
-    wcnf << "p wcnf " << nbvars << " " << nbclauses << " " << top << "\n";
-
-    int count_clauses = 0;// num_clauses is counting too many clauses because we get rid of a lot already
+    wcnf.wcnf_header(nbvars, nbclauses, top);
 
     //don't need to add unit literals as we do not add variables for edges, only for non-edges
 
     //now add all transitivity constraints, that is for i<j<k add
     // transitivity(i,j,k) & transitivity(j,i,k) & transitivity(i,k,j)
-    write_all_transitivity(count_clauses);
+    write_all_transitivity(wcnf);
     //next are the definitions of c_j as in equation 2
-    write_cj_definition(count_clauses);
+    write_cj_definition(wcnf);
 
     //for MaxSAT, add the c_j as the soft clauses
     for (int j = 1; j < num_vertices; ++j) {
-        wcnf << 1 << " " << -c_indices[j - 1] << " 0\n";
-        count_clauses++;
+        wcnf.clause({-c_indices[j - 1]}, 1);
     }
     // no need for at most k-1 constraint since we solve the MaxSAT problem
 
     if(options.verbosity >= Options::Debug) {
-        std::cout << "c Debug: " << nbvars << " vars and " << count_clauses << " clauses\n";
+        std::cout << "c Debug: " << nbvars << " vars and " << wcnf.get_num_clauses() << " clauses\n";
     }
-    std::cout << "c Debug: Wrote MaxSAT formula to " << out_name << "\n";
     wcnf.close();
+    std::cout << "c Debug: Wrote MaxSAT formula to " << out_name << "\n";
     stats.end_phase(Statistics::BuildEncoding);
 }
 
-void IncSatGC::write_all_transitivity(int &count_clauses) {
-    for (int i = 0; i < num_vertices; ++i) {
-        for (int j = i+1; j < num_vertices; ++j) {
-            for (int k = j+1; k < num_vertices; ++k) {
-                //first case transitivity(i,j,k)
-                write_transitivity(count_clauses, i, j, k);
-                //second case transitivity(j,i,k)
-                write_transitivity(count_clauses, j, i, k);
-                //third case transitivity(i,k,j)
-                write_transitivity(count_clauses, i, k, j);
-            }
-        }
-    }
-}
-
-
-void IncSatGC::write_transitivity(int &count_clauses, int i, int j, int k) {
-    int top = sij_indices.dimension; // top is num vertices is dimension
-    if((sij_indices.get(i, j) != -1) and (sij_indices.get(j, k)) != -1){
-        //both i,j and j,k are not an edge, need to ensure transitivity i,j,k
-        //unless i,k is an edge, then the clause changes slightly
-        wcnf << top << " " << -sij_indices.get(i, j) << " " << -sij_indices.get(j, k) << " ";
-        if(sij_indices.get(i, k) != -1){ //i,k also a non-edge, include in clause
-            wcnf << sij_indices.get(i, k) << " ";
-        }
-        wcnf << "0 \n";
-        count_clauses++;
-    }
+void IncSatGC::write_all_transitivity(ClauseWriter &wcnf) {
+    //for i<j<k write transitivity(i,j,k) & transitivity(j,i,k) & transitivity(i,k,j) as hard clauses,
+    //indices already start at 1
+    const int top = sij_indices.dimension; // top is num vertices is dimension
+    stream_transitivity_clauses(0, [&](const std::vector<int> &literals) {
+        wcnf.clauses(literals, top);
+    });
 }
 
-void IncSatGC::write_cj_definition(int &count_clauses) {
+void IncSatGC::write_cj_definition(ClauseWriter &wcnf) {
     int top = num_vertices;
+    std::vector<int> second_clause;
     for (int j = 1; j < num_vertices ; ++j) {
         //for each j, add clause c_j <-> AND -s_ij
         //which in cnf is AND(-c_j v -s_ij) and (ORs_ij v c_j)
         //do first clauses while collecting literals for second
-        std::vector<int> second_clause;
-        second_clause.reserve(j);
+        second_clause.clear();
         for (int i = 0; i < j; ++i) {
             if(sij_indices.get(i, j) == -1){
                 //is an edge, thus leave it out
                 continue;
             }
-            wcnf << top << " " << -c_indices[j - 1] << " " << -sij_indices.get(i, j) << " 0 \n";
-            count_clauses++;
+            wcnf.clause({-c_indices[j - 1], -sij_indices.get(i, j)}, top);
 
             second_clause.push_back(sij_indices.get(i, j));
         }
         second_clause.push_back(c_indices[j - 1]);
-        wcnf << top << " ";
-        for (int lit : second_clause) {
-            wcnf << lit << " ";
-        }
-        wcnf << "0\n";
-        count_clauses++;
+        wcnf.clause(second_clause.data(), second_clause.size(), top);
     }
 }
 
 
+void IncSatGC::check_zykov_variable_range(int start_index, long long num_sij) const {
+    //solver variables are int, only the positions of the s_ij are 64 bit
+    if (start_index + num_sij + num_vertices - 1 > std::numeric_limits<int>::max()) {
+        throw std::runtime_error("Too many s_ij variables for the SAT solver.");
+    }
+}
+
 void IncSatGC::initialise_variable_indices(int start_index) {
     //we have variables s_i,j for all i,j in V, only consider i<j so that is n(n-1)/2 in upper triangular matrix
     //only look at i,j such that (i,j) is not an edge
     //and variables c_j for 1 <= j <= n-1. keep track of indices in vectors
-    sij_indices = UpperTriangle(num_vertices);
+    long long num_sij = static_cast<long long>(num_vertices) * (num_vertices - 1) / 2 - graph.ecount();
+    check_zykov_variable_range(start_index, num_sij);
+    sij_indices = UpperTriangle(num_vertices, num_sij);
     c_indices.resize(num_vertices - 1);
     int var_index = start_index;
 
-    complement_graph_adjacency = graph.get_complement().get_neighbor_list();
+    complement_graph_adjacency = graph.get_complement_neighbor_list();
     for (int i = 0; i < num_vertices; ++i) {
         for (int j : complement_graph_adjacency[i] ) {
             if(i > j){
@@ -1657,19 +2810,127 @@ void IncSatGC::add_transitivity(int i, int j, int k) {
 
 
 
-void IncSatGC::add_all_transitivity() {
-    for (int i = 0; i < num_vertices; ++i) {
-        for (int j = i+1; j < num_vertices; ++j) {
-            for (int k = j+1; k < num_vertices; ++k) {
-                //first case transitivity(i,j,k)
-                add_transitivity(i, j, k);
-                //second case transitivity(j,i,k)
-                add_transitivity(j, i, k);
-                //third case transitivity(i,k,j)
-                add_transitivity(i, k, j);
+void IncSatGC::stream_transitivity_clauses(const int literal_offset,
+                                           const std::function<void(const std::vector<int> &)> &consume) const {
+    //the clauses of all triples i<j<k are generated row by row, the row of i holds all triples with smallest vertex i,
+    //rows are generated by the worker threads and handed to consume in order, so the output is the same as serially
+    auto generate_row = [&](const int i, std::vector<int> &literals) {
+        literals.clear();
+        auto add_clause = [&](int a, int b, int c) {
+            const int ab = sij_indices.get(a, b);
+            const int bc = sij_indices.get(b, c);
+            if (ab == -1 or bc == -1) {
+                return;
+            }
+            literals.push_back(-(ab + literal_offset));
+            literals.push_back(-(bc + literal_offset));
+            const int ac = sij_indices.get(a, c);
+            if (ac != -1) { //i,k also a non-edge, include in clause
+                literals.push_back(ac + literal_offset);
+            }
+            literals.push_back(0);
+        };
+        for (int j = i + 1; j < num_vertices; ++j) {
+            for (int k = j + 1; k < num_vertices; ++k) {
+                add_clause(i, j, k);
+                add_clause(j, i, k);
+                add_clause(i, k, j);
+            }
+        }
+    };
+
+    const int num_workers = std::min(options.num_threads, num_vertices);
+    if (num_workers <= 1) {
+        std::vector<int> literals;
+        for (int i = 0; i < num_vertices; ++i) {
+            generate_row(i, literals);
+            consume(literals);
+        }
+        return;
+    }
+
+    //workers may run at most window rows ahead of the consumer, which bounds the memory of the buffered rows
+    const int window = 4 * num_workers;
+    std::vector<std::vector<int>> row_literals(window);
+    std::vector<char> row_ready(window, false);
+    int next_row = 0;
+    int num_consumed = 0;
+    bool stop = false;
+    std::mutex mutex;
+    std::condition_variable row_done, row_free;
+    auto work = [&]() {
+        while (true) {
+            int row;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                row_free.wait(lock, [&]() { return stop or next_row >= num_vertices or next_row < num_consumed + window; });
+                if (stop or next_row >= num_vertices) {
+                    return;
+                }
+                row = next_row++;
             }
+            generate_row(row, row_literals[row % window]);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                row_ready[row % window] = true;
+            }
+            row_done.notify_all();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_workers; ++t) {
+        workers.emplace_back(work);
+    }
+    try {
+        for (int i = 0; i < num_vertices; ++i) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                row_done.wait(lock, [&]() { return row_ready[i % window]; });
+            }
+            consume(row_literals[i % window]);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                row_ready[i % window] = false;
+                num_consumed++;
+            }
+            row_free.notify_all();
+        }
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        row_free.notify_all();
+        for (std::thread &worker : workers) {
+            worker.join();
         }
+        throw;
     }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void IncSatGC::add_all_transitivity() {
+    //for i<j<k add transitivity(i,j,k) & transitivity(j,i,k) & transitivity(i,k,j)
+    std::shared_ptr<CaDiCaLAdaptor::Solver> cast_solver = std::dynamic_pointer_cast<CaDiCaLAdaptor::Solver>(solver);
+    stream_transitivity_clauses(1, [&](const std::vector<int> &literals) {
+        if (cast_solver) {
+            //literals are generated in cadical format, so they are added without going through vec<Lit>
+            cast_solver->add_clauses(literals);
+            stats.num_transitivity_clauses += static_cast<int>(std::count(literals.begin(), literals.end(), 0));
+            return;
+        }
+        for (int lit : literals) {
+            if (lit != 0) {
+                tmp_clause.push(mkLit(std::abs(lit) - 1, lit < 0));
+                continue;
+            }
+            solver->addClause(tmp_clause);
+            tmp_clause.clear();
+            stats.num_transitivity_clauses++;
+        }
+    });
 }
 
 void IncSatGC::add_cj_definition() {
@@ -1739,12 +3000,119 @@ void IncSatGC::add_zykov_encoding() {
     if(options.encoding == Options::ZykovPropagator) {
         init_zykov_propagator();
     }
+
+    //no k >= upper_bound is searched, so the root fixings for upper_bound - 1 colors hold for all later k
+    if(options.probe_sij_variables and lower_bound < upper_bound) {
+        probe_sij_variables(options.strategy == Options::SingleK ? options.specific_num_colors.value() : upper_bound - 1);
+    }
     stats.end_phase(Statistics::BuildEncoding);
 }
 
+void IncSatGC::probe_sij_variables(const int num_colors) {
+    if(has_probed_sij) {
+        //encoding was rebuilt, the bound only got smaller so the earlier units still hold
+        for (Lit unit : probing_units) {
+            solver->addClause(unit);
+        }
+        return;
+    }
+    has_probed_sij = true;
+    const MGraph base_graph(num_vertices, graph.ecount(), graph.elist());
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(options.probing_time_limit);
+    const long long num_candidates = static_cast<long long>(num_vertices) * (num_vertices - 1) / 2 - graph.ecount();
+
+    //the graph after the operation needs more than num_colors colors if the clique through the changed vertices
+    //is too large, or if a clique that is close enough can be extended to a large enough mycielski graph
+    auto needs_more_colors = [&](MGraph &probe_graph, MGraph::MycielskyCache &cache, const Bitset &clique) {
+        int clique_size = static_cast<int>(clique.count());
+        if(clique_size > num_colors) {
+            return true;
+        }
+        int gap = num_colors - clique_size;
+        if(gap >= options.mycielsky_threshold) {
+            return false;
+        }
+        probe_graph.update_mycielsky_cache(cache);
+        MGraph::SubGraph subgraph(clique);
+        return probe_graph.mycielsky_extension_clique(subgraph, gap + 1, cache) > gap;
+    };
+    //the candidates are the non-edges {u,v} with u < v, taken from the complement row by row as they are probed.
+    //merging u and v fails: -s_uv, separating them fails: s_uv. if both fail there is no coloring and the solver
+    //finds the conflict
+    const int num_workers = std::min(options.num_threads, std::max(1, num_vertices));
+    std::vector<std::vector<Lit>> worker_units(num_workers);
+    std::atomic<int> next_row{0};
+    std::atomic<long long> num_probed{0};
+    auto probe = [&](std::vector<Lit> &units) {
+        //every worker works on its own copy and undoes the operation by backtracking to the root
+        MGraph probe_graph = base_graph;
+        MGraph::MycielskyCache cache(num_vertices);
+        bool timed_out = false;
+        for (int u = next_row++; u < num_vertices and not timed_out; u = next_row++) {
+            for (int v : complement_graph_adjacency[u]) {
+                if(v < u) {
+                    continue;
+                }
+                if(std::chrono::steady_clock::now() >= deadline) {
+                    timed_out = true;
+                    break;
+                }
+                probe_graph.notify_new_level();
+                probe_graph.contract_vertices(u, v);
+                Bitset clique = probe_graph.greedy_clique_in(probe_graph.gmatrix[u]);
+                clique.set(u); //u < v is the representative of the merged vertex
+                if(needs_more_colors(probe_graph, cache, clique)) {
+                    units.push_back(mkLit(sij_indices.get(u, v), true));
+                }
+                probe_graph.notify_backtrack_level(0);
+
+                probe_graph.notify_new_level();
+                probe_graph.separate_vertices(u, v);
+                clique = probe_graph.greedy_clique_in(probe_graph.gmatrix[u] & probe_graph.gmatrix[v]);
+                clique.set(u);
+                clique.set(v);
+                if(needs_more_colors(probe_graph, cache, clique)) {
+                    units.push_back(mkLit(sij_indices.get(u, v), false));
+                }
+                probe_graph.notify_backtrack_level(0);
+                num_probed++;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < num_workers; ++t) {
+        workers.emplace_back(probe, std::ref(worker_units[t]));
+    }
+    probe(worker_units[0]);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    for (const std::vector<Lit> &units : worker_units) {
+        probing_units.insert(probing_units.end(), units.begin(), units.end());
+    }
+    for (Lit unit : probing_units) {
+        solver->addClause(unit);
+    }
+    stats.num_probed_sij = static_cast<int>(num_probed);
+    stats.num_fixed_sij = static_cast<int>(probing_units.size());
+    if(options.verbosity >= Options::Verbose) {
+        std::cout << "c Probing: fixed " << probing_units.size() << " s_ij for " << num_colors << " colors after probing "
+                  << num_probed << " of " << num_candidates << " at " << stats.current_total_time() << "\n";
+    }
+}
+
 void IncSatGC::add_at_most_k(int k) {
     assert(options.strategy == Options::SingleK or options.non_incremental_solving);
     assert(not cj_literals.size());
+    //the zykov propagator counts the c_j itself, changing k only changes its bound
+    if(options.encoding == Options::ZykovPropagator and options.propagate_cardinality_constraints) {
+        assert(zykov_propagator != nullptr);
+        zykov_propagator->update_num_colors(k + 1);
+        if(options.verbosity >= Options::Debug){
+            std::cout << "c Debug: No cardinality constraints added, at most " << k << " c_j are propagated by the propagator\n";
+        }
+        return;
+    }
     //catch case that cardinality constraints are handled by cliques in zykov propagator
     if(options.encoding == Options::ZykovPropagator and options.disable_cardinality_constraints) {
         assert(zykov_propagator != nullptr);
@@ -1810,6 +3178,15 @@ void IncSatGC::add_at_most_k(int k) {
 
 void IncSatGC::add_incremental_at_most_k(int k) {
     assert(options.strategy != Options::SingleK);
+    //the zykov propagator counts the c_j itself, changing k only changes its bound
+    if(options.encoding == Options::ZykovPropagator and options.propagate_cardinality_constraints) {
+        assert(zykov_propagator != nullptr);
+        zykov_propagator->update_num_colors(k + 1);
+        if(options.verbosity >= Options::Debug){
+            std::cout << "c Debug: No cardinality constraints added, at most " << k << " c_j are propagated by the propagator\n";
+        }
+        return;
+    }
     //catch case that cardinality constraints are handled by cliques in zykov propagator
     if(options.encoding == Options::ZykovPropagator and options.disable_cardinality_constraints) {
         assert(zykov_propagator != nullptr);
@@ -1920,7 +3297,7 @@ bool IncSatGC::zykov_encoding_single_k() {
     notify_new_bound(res, num_colors);
     if(res){
         notify_upper_bound(num_colors);
-        current_best_coloring = obtain_coloring_from_model();
+        current_best_coloring = obtain_zykov_coloring();
     }
     else{
         notify_lower_bound(num_colors + 1);
@@ -1939,6 +3316,7 @@ int IncSatGC::zykov_encoding_top_down() {
     add_zykov_encoding();
     //for at most k constraints, start with one less than the best known SAT result
     int num_colors = upper_bound - 1;
+    share_bounds();
     //start top down solving
     while(lower_bound != upper_bound) {//outer loop, decreasing num colors
         add_incremental_at_most_k(num_colors - 1);
@@ -1950,7 +3328,7 @@ int IncSatGC::zykov_encoding_top_down() {
             notify_upper_bound(num_colors);
             //found a k-coloring, decrease number of colors and continue
             //check if model actually uses fewer colors already
-            current_best_coloring = obtain_coloring_from_model();
+            current_best_coloring = obtain_zykov_coloring();
             int num_colors_used = *std::max_element(current_best_coloring.begin(), current_best_coloring.end()) + 1;
             if(num_colors_used < num_colors){
                 notify_upper_bound(num_colors_used);
@@ -1962,6 +3340,7 @@ int IncSatGC::zykov_encoding_top_down() {
         else {//not satisfiable. chromatic number is current upper bound, stop loop
             notify_lower_bound(upper_bound);
         }
+        share_bounds();
     }
     //chromatic number is lower_bound=upper_bound
     stats.solved = true;
@@ -1978,6 +3357,7 @@ int IncSatGC::zykov_encoding_bottom_up() {
     //initialise variable indices, add all the transitivity constraints and clauses defining the c_j, or zykov propagator
     add_zykov_encoding();
     int num_colors = lower_bound;
+    share_bounds();
     //start bottom up solving
     while(lower_bound != upper_bound) {//outer loop, increasing num colors
         if (options.non_incremental_solving == true) {
@@ -1996,7 +3376,7 @@ int IncSatGC::zykov_encoding_bottom_up() {
         notify_new_bound(res, num_colors);
         if (res){//found a k-coloring, became satisfiable
             notify_upper_bound(num_colors);
-            current_best_coloring = obtain_coloring_from_model();
+            current_best_coloring = obtain_zykov_coloring();
             assert(*std::max_element(current_best_coloring.begin(), current_best_coloring.end()) + 1 == num_colors);
             assert(lower_bound == upper_bound);
             //loop stops here
@@ -2005,6 +3385,7 @@ int IncSatGC::zykov_encoding_bottom_up() {
             notify_lower_bound(num_colors + 1);
             num_colors++;
         }
+        share_bounds();
     }
     //chromatic number is lower_bound=upper_bound
     stats.solved = true;
@@ -2013,6 +3394,39 @@ int IncSatGC::zykov_encoding_bottom_up() {
 
 
 
+int IncSatGC::zykov_encoding_bisection() {
+    assert(options.encoding == Options::ZykovPropagator);
+    assert(options.propagate_cardinality_constraints or options.disable_cardinality_constraints);
+    //the propagator handles the bound on the number of colors, so k can move in both directions without new clauses
+    add_zykov_encoding();
+    int gallop_step = 1;
+    while(lower_bound != upper_bound) {
+        int num_colors = bisection_num_colors(gallop_step);
+        add_incremental_at_most_k(num_colors - 1);
+        print_sat_size();
+
+        bool res = zykov_encoding_run_solver();
+        notify_new_bound(res, num_colors);
+        if (res){
+            notify_upper_bound(num_colors);
+            current_best_coloring = obtain_zykov_coloring();
+            int num_colors_used = *std::max_element(current_best_coloring.begin(), current_best_coloring.end()) + 1;
+            if(num_colors_used < num_colors){
+                notify_upper_bound(num_colors_used);
+                notify_already_used_fewer_colors(num_colors_used);
+            }
+            gallop_step = std::max(1, gallop_step / 2);
+        }
+        else {
+            notify_lower_bound(num_colors + 1);
+            gallop_step *= 2;
+        }
+    }
+    //chromatic number is lower_bound=upper_bound
+    stats.solved = true;
+    return upper_bound;
+}
+
 int IncSatGC::do_full_encoding() {
     switch (options.strategy) {
         case Options::SingleK:
@@ -2115,6 +3529,8 @@ ConflictList IncSatGC::find_conflicts() const {
             return find_conflicts_all_triangles();
         case Options::PaperChecker:
             return find_conflicts_paper();
+        case Options::UnionFindChecker:
+            return find_conflicts_union_find();
         default:
             throw std::runtime_error("Invalid option set for checker algorithm.");
     }
@@ -2148,49 +3564,112 @@ ConflictList IncSatGC::find_conflicts_naive() const {
     return conflicts;
 }
 
-Graph::NeighborList IncSatGC::get_pairing_graph(const Model &model) const {
-    Graph::NeighborList pairing_graph(num_vertices);
-    //add edge for each s_ij set to true in model, iterate over each non-edge to check
-    for (int i = 0; i < num_vertices; ++i) {
-        for (int j : complement_graph_adjacency[i] ) {
-            if(i > j){
-                //only want to look at (i,j) once
-                continue;
+void IncSatGC::read_sij_values() const {
+    //read only the s_ij from the solver, they are the first variables
+    const int num_sij = stats.num_sij_vars;
+    sij_values.resize(num_sij);
+    sij_values.reset();
+    if (options.solver == Options::CaDiCaL) {
+        std::shared_ptr<CaDiCaLAdaptor::Solver> cast_solver = std::dynamic_pointer_cast<CaDiCaLAdaptor::Solver>(solver);
+        if (not cast_solver) { //solver ptr was not of type CaDiCaLAdaptor::Solver
+            throw std::runtime_error("Solver* was of the wrong type.");
+        }
+        for (int var = 0; var < num_sij; ++var) {
+            if (cast_solver->solver.val(var + 1) > 0) { //cadical indices start at 1
+                sij_values.set(var);
             }
-            if(get_model_ij(model, i, j)) {
-                pairing_graph[i].push_back(j);
-                pairing_graph[j].push_back(i);
+        }
+    }
+    else {
+        for (int var = 0; var < num_sij; ++var) {
+            if (solver->modelValue(var) == l_True) {
+                sij_values.set(var);
             }
         }
     }
-    return pairing_graph;
 }
 
-ConflictList IncSatGC::find_conflicts_sparse_triangles() const {
-    //idea for this checker: same as find_conflicts_all_triangles but only add one conflcit for each visited vertex
-    ConflictList conflicts;
-    Model model = get_model();
-    Graph::NeighborList pairing_graph = get_pairing_graph(model);
-
-    //constructed graph with edges all the s_i set to true,
-    // iterate over all its vertices
-    // and for each pair of edges, check whether there is also the third edge in the triangle -> if not, conflict
-    // runtime n max_d^2, where max degree should be relatively small, since we look only at all s_ij that are true
-    for (int vertex_j = 0; vertex_j < num_vertices; vertex_j++) {
-        //next, iterate over pairs of neighbours
-        bool found_conflict = false;
-        for(auto i_it = pairing_graph[vertex_j].begin(); i_it != pairing_graph[vertex_j].end() and not found_conflict; ++i_it){
-            for (auto k_it = std::next(i_it); k_it != pairing_graph[vertex_j].end() and not found_conflict; ++k_it) {
-                //from the pairing graph we know that s_ij and s_jk are true, check for s_ik
-                if(not get_model_ij(model, *i_it, *k_it)){
-                    //found a conflict: s_ij and s_jk are true but s_ik is not
-                    conflicts.emplace_back(*i_it, vertex_j, *k_it);
-                    //found conflict for vertex_j, continue with next vertex by exiting both inner loops
-                    found_conflict = true;
+void IncSatGC::build_pairing_rows() const {
+    read_sij_values();
+    pairing_row_words = (num_vertices + 63) / 64;
+    pairing_rows.assign(static_cast<std::size_t>(num_vertices) * pairing_row_words, 0);
+    //only the true s_ij are visited, the index of the variable gives its pair of vertices
+    for (auto var = sij_values.find_first(); var != Bitset::npos; var = sij_values.find_next(var)) {
+        auto [i, j] = sij_indices.get_ij(static_cast<int>(var));
+        pairing_rows[static_cast<std::size_t>(i) * pairing_row_words + j / 64] |= std::uint64_t(1) << (j % 64);
+        pairing_rows[static_cast<std::size_t>(j) * pairing_row_words + i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+}
+
+ConflictList IncSatGC::find_triangle_conflicts(const bool one_per_vertex) const {
+    build_pairing_rows();
+    const std::size_t words = pairing_row_words;
+
+    //for a vertex j and a neighbour i in the pairing graph, every later neighbour k of j that is not a neighbour of i
+    // gives a conflict (i, j, k), so the k are read off the word-wise difference of the rows of j and i
+    auto check_vertex = [&](const int vertex_j, ConflictList &conflicts) {
+        const std::uint64_t *row_j = &pairing_rows[static_cast<std::size_t>(vertex_j) * words];
+        for (std::size_t i_word = 0; i_word < words; ++i_word) {
+            for (std::uint64_t i_bits = row_j[i_word]; i_bits != 0; i_bits &= i_bits - 1) {
+                const int vertex_i = static_cast<int>(i_word * 64) + __builtin_ctzll(i_bits);
+                const std::uint64_t *row_i = &pairing_rows[static_cast<std::size_t>(vertex_i) * words];
+                //only k > i, so every pair i,k is visited once
+                const int first_k = vertex_i + 1;
+                for (std::size_t k_word = first_k / 64; k_word < words; ++k_word) {
+                    std::uint64_t k_bits = row_j[k_word] & ~row_i[k_word];
+                    if (k_word == static_cast<std::size_t>(first_k / 64)) {
+                        k_bits &= ~std::uint64_t(0) << (first_k % 64);
+                    }
+                    for (; k_bits != 0; k_bits &= k_bits - 1) {
+                        const int vertex_k = static_cast<int>(k_word * 64) + __builtin_ctzll(k_bits);
+                        //found a conflict: s_ij and s_jk are true but s_ik is not
+                        conflicts.emplace_back(vertex_i, vertex_j, vertex_k);
+                        if (one_per_vertex) {
+                            return;
+                        }
+                    }
                 }
             }
         }
+    };
+
+    //chunks of vertices are handed out dynamically, each chunk has its own buffer and they are concatenated in order
+    constexpr int chunk_size = 64;
+    const int num_chunks = (num_vertices + chunk_size - 1) / chunk_size;
+    std::vector<ConflictList> chunk_conflicts(num_chunks);
+    std::atomic<int> next_chunk = 0;
+    auto check_chunks = [&]() {
+        for (int chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+            const int end = std::min(num_vertices, (chunk + 1) * chunk_size);
+            for (int vertex_j = chunk * chunk_size; vertex_j < end; ++vertex_j) {
+                check_vertex(vertex_j, chunk_conflicts[chunk]);
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < std::min(options.num_threads, num_chunks); ++t) {
+        threads.emplace_back(check_chunks);
     }
+    check_chunks();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    ConflictList conflicts;
+    std::size_t num_conflicts = 0;
+    for (const ConflictList &list : chunk_conflicts) {
+        num_conflicts += list.size();
+    }
+    conflicts.reserve(num_conflicts);
+    for (const ConflictList &list : chunk_conflicts) {
+        conflicts.insert(conflicts.end(), list.begin(), list.end());
+    }
+    return conflicts;
+}
+
+ConflictList IncSatGC::find_conflicts_sparse_triangles() const {
+    //idea for this checker: same as find_conflicts_all_triangles but only add one conflcit for each visited vertex
+    ConflictList conflicts = find_triangle_conflicts(true);
     if(conflicts.empty()){
         assert(find_conflicts_naive().empty());
     }
@@ -2202,26 +3681,8 @@ ConflictList IncSatGC::find_conflicts_all_triangles() const {
     //for all pairs of edges, add their transitivity constraints
     //this covers all current conflicts
     //Basically the same as Connected component checker,
-    ConflictList conflicts;
-    Model model = get_model();
-    Graph::NeighborList pairing_graph = get_pairing_graph(model);
-
-    //constructed graph with edges all the s_i set to true,
-    // iterate over all its vertices
-    // and for each pair of edges, check whether there is also the third edge in the triangle -> if not, conflict
-    // runtime n max_d^2, where max degree should be relatively small, since we look only at all s_ij that are true
-    for (int vertex_j = 0; vertex_j < num_vertices; vertex_j++) {
-        //next, iterate over pairs of neighbours
-        for(auto i_it = pairing_graph[vertex_j].begin(); i_it != pairing_graph[vertex_j].end(); ++i_it){
-            for (auto k_it = std::next(i_it); k_it != pairing_graph[vertex_j].end(); ++k_it) {
-                //from the pairing graph we know that s_ij and s_jk are true, check for s_ik
-                if(not get_model_ij(model, *i_it, *k_it)){
-                    //found a conflict: s_ij and s_jk are true but s_ik is not
-                    conflicts.emplace_back(*i_it, vertex_j, *k_it);
-                }
-            }
-        }
-    }
+    // runtime n max_d^2 / 64, where max degree should be relatively small, since we look only at all s_ij that are true
+    ConflictList conflicts = find_triangle_conflicts(false);
     if(conflicts.empty()){
         assert(find_conflicts_naive().empty());
     }
@@ -2232,7 +3693,8 @@ ConflictList IncSatGC::find_conflicts_all_triangles() const {
 ConflictList IncSatGC::find_conflicts_paper() const {
     //store found conflicts
     ConflictList conflicts;
-    Model model = get_model();
+    //the sweep depends on the colors chosen for earlier vertices, so it stays serial, but the s_ij are read from bit rows
+    build_pairing_rows();
     int num_colors;
     switch (options.strategy) {
         case Options::TopDown:
@@ -2269,12 +3731,12 @@ ConflictList IncSatGC::find_conflicts_paper() const {
         //inner loop
         for (int v = u + 1; v < num_vertices; ++v) {
             //check whether -s_uv is in the pairing
-            if (not get_model_ij(model, u, v)) {
+            if (not is_paired(u, v)) {
                 //update c[v] = c[v]\c[u] i.e. set c[v][index] = false
                 c[v].reset(index);
                 if (c[v].none()) {
                     for (int w = 0; w < u; ++w) {
-                        if( get_model_ij(model, w, v) and (c[w] == c[u])) {
+                        if( is_paired(w, v) and (c[w] == c[u])) {
                             //CONFLICT TYPE ii, add transitivity(u,w,v)
                             conflicts.emplace_back(u, w, v); //w < u < v
                         }
@@ -2291,7 +3753,7 @@ ConflictList IncSatGC::find_conflicts_paper() const {
                             //do not consider if w is empty, otherwise redundant triples are added
                             continue;
                         }
-                        bool model_wv = get_model_ij(model, w, v);
+                        bool model_wv = is_paired(w, v);
                         if (model_wv and (c[w] != c[u])) {
                             //CONFLICT TYPE iii, add transitivity(u,v,w)
                             conflicts.emplace_back(u, v, w);
@@ -2315,6 +3777,156 @@ ConflictList IncSatGC::find_conflicts_paper() const {
 }
 
 
+int IncSatGC::find_component(int v) const {
+    //path halving
+    while (component_parent[v] != v) {
+        component_parent[v] = component_parent[component_parent[v]];
+        v = component_parent[v];
+    }
+    return v;
+}
+
+bool IncSatGC::sij_value(const int i, const int j) const {
+    //edges of the graph are never paired
+    return (sij_indices.get(i, j) != -1) and sij_values[sij_indices.get(i, j)];
+}
+
+ConflictList IncSatGC::find_conflicts_union_find() const {
+    ConflictList conflicts;
+    read_sij_values();
+
+    //union all pairs with s_ij true, and remember the pairs that merged two components as a spanning forest
+    component_parent.resize(num_vertices);
+    std::iota(component_parent.begin(), component_parent.end(), 0);
+    component_size.assign(num_vertices, 1);
+    tree_edges.clear();
+    for (int i = 0; i < num_vertices; ++i) {
+        for (int j : complement_graph_adjacency[i]) {
+            if (i > j or not sij_values[sij_indices.get(i, j)]) {
+                continue;
+            }
+            int root_i = find_component(i);
+            int root_j = find_component(j);
+            if (root_i == root_j) {
+                continue;
+            }
+            if (component_size[root_i] < component_size[root_j]) {
+                std::swap(root_i, root_j);
+            }
+            component_parent[root_j] = root_i;
+            component_size[root_i] += component_size[root_j];
+            tree_edges.insert(tree_edges.end(), {i, j});
+        }
+    }
+
+    component_root.resize(num_vertices);
+    for (int v = 0; v < num_vertices; ++v) {
+        component_root[v] = find_component(v);
+    }
+
+    //a component is consistent iff all its vertices are pairwise non-adjacent and paired,
+    //so for every vertex all other vertices of its component are non-neighbours with s_ij true
+    bool built_trees = false;
+    for (int u = 0; u < num_vertices; ++u) {
+        const int root = component_root[u];
+        if (component_size[root] == 1) {
+            continue;
+        }
+        int violating_v = -1;
+        int paired_non_neighbours = 0;
+        for (int v : complement_graph_adjacency[u]) {
+            if (component_root[v] != root) {
+                continue;
+            }
+            if (sij_values[sij_indices.get(u, v)]) {
+                paired_non_neighbours++;
+            }
+            else if (violating_v == -1) {
+                violating_v = v;
+            }
+        }
+        if (violating_v == -1 and paired_non_neighbours < component_size[root] - 1) {
+            //some neighbour of u is in the same component
+            for (int v = 0; v < num_vertices; ++v) {
+                if (v != u and component_root[v] == root and sij_indices.get(u, v) == -1) {
+                    violating_v = v;
+                    break;
+                }
+            }
+        }
+        if (violating_v == -1) {
+            continue;
+        }
+
+        if (not built_trees) {
+            //union-find does not give paths, so root a spanning tree of every component with bfs over the forest edges,
+            //component_parent is reused for the tree parents from here on
+            built_trees = true;
+            tree_adjacency_start.assign(num_vertices + 1, 0);
+            for (int e : tree_edges) {
+                tree_adjacency_start[e + 1]++;
+            }
+            std::partial_sum(tree_adjacency_start.begin(), tree_adjacency_start.end(), tree_adjacency_start.begin());
+            tree_adjacency.resize(tree_edges.size());
+            bfs_queue.assign(tree_adjacency_start.begin(), tree_adjacency_start.end() - 1); //insert positions
+            for (std::size_t e = 0; e < tree_edges.size(); e += 2) {
+                tree_adjacency[bfs_queue[tree_edges[e]]++] = tree_edges[e + 1];
+                tree_adjacency[bfs_queue[tree_edges[e + 1]]++] = tree_edges[e];
+            }
+            tree_depth.assign(num_vertices, -1);
+            for (int r = 0; r < num_vertices; ++r) {
+                if (tree_depth[r] != -1) {
+                    continue;
+                }
+                tree_depth[r] = 0;
+                component_parent[r] = r;
+                bfs_queue.clear();
+                bfs_queue.push_back(r);
+                for (std::size_t head = 0; head < bfs_queue.size(); ++head) {
+                    int x = bfs_queue[head];
+                    for (int pos = tree_adjacency_start[x]; pos < tree_adjacency_start[x + 1]; ++pos) {
+                        int y = tree_adjacency[pos];
+                        if (tree_depth[y] == -1) {
+                            tree_depth[y] = tree_depth[x] + 1;
+                            component_parent[y] = x;
+                            bfs_queue.push_back(y);
+                        }
+                    }
+                }
+            }
+        }
+
+        //tree path from u to violating_v, all consecutive pairs are true s_ij but the end points are not paired,
+        //so along the path there is a first vertex p_t not paired with u, and (u, p_{t-1}, p_t) is a violated triple
+        int a = u, b = violating_v;
+        path_from_u.clear();
+        path_from_v.clear();
+        while (a != b) {
+            if (tree_depth[a] >= tree_depth[b]) {
+                path_from_u.push_back(a);
+                a = component_parent[a];
+            }
+            else {
+                path_from_v.push_back(b);
+                b = component_parent[b];
+            }
+        }
+        path_from_u.push_back(a);
+        path_from_u.insert(path_from_u.end(), path_from_v.rbegin(), path_from_v.rend());
+        assert(path_from_u.size() >= 3 and path_from_u.back() == violating_v);
+        for (std::size_t t = 2; t < path_from_u.size(); ++t) {
+            if (not sij_value(u, path_from_u[t])) {
+                conflicts.emplace_back(u, path_from_u[t - 1], path_from_u[t]);
+                break;
+            }
+        }
+    }
+    if(conflicts.empty()){
+        assert(find_conflicts_naive().empty());
+    }
+    return conflicts;
+}
+
 void IncSatGC::add_conflict_clauses(const ConflictList &conflicts) {
     for (const auto &conflict : conflicts) {
         auto [i,j,k] = conflict;
@@ -2337,6 +3949,9 @@ int IncSatGC::do_zykov_propagator() {
         case Options::BottomUp:
             zykov_propagator_bottom_up();
             break;
+        case Options::Bisection:
+            zykov_encoding_bisection();
+            break;
         default:
             throw std::runtime_error("Invalid option for search strategy.");
     }
@@ -2350,7 +3965,7 @@ void IncSatGC::init_zykov_propagator() {
     assert(cadical_extended != nullptr);
     CaDiCaL::Solver* cadical_solver = &(cadical_extended->solver);
     assert(cadical_solver != nullptr);
-    zykov_propagator = std::make_unique<CadicalZykovPropagator>(CadicalZykovPropagator(*this));
+    zykov_propagator = std::make_unique<CadicalZykovPropagator>(*this);
     cadical_solver->connect_external_propagator(zykov_propagator.get());
 
 
@@ -2373,7 +3988,42 @@ void IncSatGC::init_zykov_propagator() {
         cadical_solver->add_observed_var(c_indices[j - 1] + 1);//index + 1 for cadical
     }
     //3. do not add any transitivity constraints, these will be handled by the propagator
-    // the cardinality constraints also follow externally, or later potentially as part of the propagator too
+    // the cardinality constraints also follow externally, or are counted by the propagator
+}
+
+int IncSatGC::do_assignment_propagator() {
+    if (options.solver != Options::CaDiCaL) {
+        throw std::runtime_error("Propagators are only supported by Cadical");
+    }
+    switch (options.strategy) {
+        case Options::SingleK:
+            direct_encoding_single_k();
+            break;
+        case Options::TopDown:
+            direct_encoding_top_down();
+            break;
+        case Options::BottomUp:
+            direct_encoding_bottom_up();
+            break;
+        case Options::Bisection:
+            direct_encoding_bisection();
+            break;
+        default:
+            throw std::runtime_error("Invalid option for search strategy.");
+    }
+    return 0;
+}
+
+void IncSatGC::init_assignment_propagator(const int num_colors) {
+    //connect the propagator to the solver and observe all x_v,c, which are the first num_colors * |V| variables
+    std::shared_ptr<CaDiCaLAdaptor::Solver> cadical_extended = std::dynamic_pointer_cast<CaDiCaLAdaptor::Solver>(solver);
+    assert(cadical_extended != nullptr);
+    CaDiCaL::Solver* cadical_solver = &(cadical_extended->solver);
+    assignment_propagator = std::make_unique<CadicalAssignmentPropagator>(*this, num_colors);
+    cadical_solver->connect_external_propagator(assignment_propagator.get());
+    for (int var = 1; var <= num_colors * num_vertices; ++var) {
+        cadical_solver->add_observed_var(var);
+    }
 }
 
 bool IncSatGC::zykov_propagator_single_k() {
@@ -2396,11 +4046,13 @@ int IncSatGC::original_paper_configuration() {
     //we have variables s_i,j for all i,j in V, only consider i<j so that is n(n-1)/2 in upper triangular matrix
     //only look at i,j such that (i,j) is not an edge
     //and variables c_j for 1 <= j <= n-1. keep track of indices in vectors
-    sij_indices = UpperTriangle(num_vertices);
+    long long num_sij = static_cast<long long>(num_vertices) * (num_vertices - 1) / 2;
+    check_zykov_variable_range(0, num_sij);
+    sij_indices = UpperTriangle(num_vertices, num_sij);
     c_indices.resize(num_vertices - 1);
     int var_index = 0;
 
-    complement_graph_adjacency = graph.get_complement().get_neighbor_list();
+    complement_graph_adjacency = graph.get_complement_neighbor_list();
     for (int i = 0; i < num_vertices; ++i) {
         for (int j = i + 1; j < num_vertices; ++j) {
             //i and j are not adjacent in original graph
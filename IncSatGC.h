@@ -6,6 +6,8 @@
 
 
 #include <vector>
+#include <cstdint>
+#include <algorithm>
 #include <iostream>
 #include <chrono> //time keeping
 #include <ctime> //cputime with clock()
@@ -17,6 +19,15 @@
 #include <filesystem> //check that external binary file exists
 #include <csignal> //exit signals and handing
 #include <regex>
+#include <queue>
+#include <thread> //solve pieces of a decomposed graph in parallel
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <future> //bounds computed concurrently in preprocessing
+#include <condition_variable>
+#include <functional>
+#include <charconv> //fast formatting of clauses
 
 #include "core/Solver.h" //base glucose solver
 #include "utils/System.h" //cpuTime and memUsed functions
@@ -29,14 +40,19 @@
 #include <boost/process/v1/start_dir.hpp>
 #include <boost/graph/adjacency_list.hpp> //graph we use when computing connected components
 #include <boost/graph/connected_components.hpp> //connected components algorithm
+#include <boost/graph/biconnected_components.hpp> //blocks of the graph, separated by cut vertices
 #include <boost/dynamic_bitset.hpp> //dynamic size bitsets for faster logic operations
 
 #include "Graph.h"
+#include "MaxClique.h" //in-process maximum clique solver
+#include "TabuSearch.h" //local search to improve the initial coloring
 #include "Options.h"  //options struct for different settings of the algorithm
 #include "Statistics.h" //struct to store and write statistics
 #include "ExtendSolvers.h" //adapts cadical to use with cardinality encodings
 #include "CadicalZykovPropagator.h" //implements specific ExternalPropagator that solves problem with callbacks
+#include "CadicalAssignmentPropagator.h" //ExternalPropagator for the assignment encoding
 #include "FractionalBound.h" //functions to compute fractional chromatic number
+#include "ClauseWriter.h" //buffered output of cnf and wcnf files
 
 
 //some typedefs
@@ -50,45 +66,69 @@ using ConflictList = std::vector<std::tuple<int, int, int>>; //list of triplets
 
 
 //helper struct to store and get indices for the variables s_ij for all i<j
-//stores the upper triangular matrix in a continuous vector
+//only the pairs that get a variable are stored, as sorted columns per row with the offset of each row, and the row of
+//each pair to decode an index in constant time. the variables are numbered consecutively, so the index of a pair is
+//its position in the columns. memory is 8 bytes per stored pair, positions are 64 bit
 //rows and columns begin at 0
 struct UpperTriangle{
     UpperTriangle();
-    explicit UpperTriangle(int dimension, int value = -1);
-    [[nodiscard]] int index(int row, int col) const ;
+    //reserves space for the given number of pairs
+    explicit UpperTriangle(int dimension, long long num_pairs = 0);
+    //pairs have to be set in increasing order of row and column, with consecutive values
     void set(int row, int col, int val);
+    //-1 if the pair has no variable
     [[nodiscard]] int get(int row, int col) const;
     [[nodiscard]] std::pair<int, int> get_ij(int index) const;
 
     int dimension;
-    std::vector<int> sij_indices;
-    std::vector<std::pair<int, int>> index_to_ij;
+    int first_value = -1;
+    std::vector<long long> row_begin; //position of the first pair of each row, filled up to the last set row
+    int num_started_rows = 0;
+    std::vector<int> columns;
+    std::vector<int> rows;
 };
 
-inline int UpperTriangle::index(int row, int col) const{
-    assert(row != col);
-    if(row > col){std::swap(row, col);}
-    return row * dimension - row * (row + 1) / 2 + col - row - 1;
-}
-
 inline void UpperTriangle::set(const int row, const int col, const int val) {
-    sij_indices[index(row, col)] = val;
-    index_to_ij[val] = {row, col};
+    assert(row < col);
+    assert(rows.empty() or rows.back() < row or (rows.back() == row and columns.back() < col)); //set in order
+    if (columns.empty()) {
+        first_value = val;
+    }
+    assert(val == first_value + static_cast<long long>(columns.size()));
+    while (num_started_rows <= row) {
+        row_begin[num_started_rows++] = static_cast<long long>(columns.size());
+    }
+    columns.push_back(col);
+    rows.push_back(row);
 }
 
-inline int UpperTriangle::get(const int row, const int col) const{
-    return sij_indices[index(row, col)];
+inline int UpperTriangle::get(int row, int col) const{
+    assert(row != col);
+    if(row > col){std::swap(row, col);}
+    if (row >= num_started_rows) {
+        return -1;
+    }
+    auto row_end = columns.begin() + (row + 1 < num_started_rows ? row_begin[row + 1]
+                                                                   : static_cast<long long>(columns.size()));
+    auto position = std::lower_bound(columns.begin() + row_begin[row], row_end, col);
+    if (position == row_end or *position != col) {
+        return -1;
+    }
+    return first_value + static_cast<int>(position - columns.begin());
 }
 
 inline std::pair<int, int> UpperTriangle::get_ij(int index) const{
-    return index_to_ij[index];
+    const std::size_t position = index - first_value;
+    assert(position < columns.size());
+    return {rows[position], columns[position]};
 }
 
 //main class object which is instantiated to run the algorithm
 class IncSatGC {
 public:
     explicit IncSatGC(const char *filename, Options options = Options());
-    explicit IncSatGC(Graph::Graph in_graph, Options options_ = Options());
+    //a subproblem is a piece of a decomposed graph, it is solved quietly and doesn't write anything on exit
+    explicit IncSatGC(Graph::Graph in_graph, Options options_ = Options(), bool is_subproblem = false);
 
     ~IncSatGC() = default; //shared_ptr of solver is automatically deleted, default destructor is sufficient
 
@@ -122,6 +162,9 @@ private:
     int get_num_vars() const;
     int get_num_clauses() const;
     bool run_solver();
+    //phases of the solver are set from current_best_coloring, and only updated when a different coloring is known
+    ColorMap phase_coloring;
+    void set_phases_from_coloring(CaDiCaLAdaptor::Solver &cadical);
     void write_cnf();
     //returns the current model after a successful call to the solver
     Model get_model() const;
@@ -129,11 +172,9 @@ private:
     bool get_model_ij(const Model &model, int i, int j) const;
 
     //variables used in zykov tree encodings
-    Graph::NeighborList complement_graph_adjacency; //to quickly iterate over non-neighbours
+    Graph::CompactNeighborList complement_graph_adjacency; //to quickly iterate over non-neighbours
     UpperTriangle sij_indices; //for the pairing variables s_ij = true <=> same(i,j)
     std::vector<int> c_indices; //for the c_j variables used to count the number of colors used
-    //filestream used to write full MaxSAT encoding
-    std::ofstream wcnf;
     //Encoder to generate and add the clauses for at most k constraint
     openwbo::Encoder encoder;
     vec<Lit> encoder_assumptions;
@@ -147,26 +188,50 @@ private:
     ColorMap current_best_coloring;
     // data computed in preprocessing and preprocessing functions
     bool solved_in_preprocessing;
+    //whether this instance solves a piece of a decomposed graph
+    const bool is_subproblem;
     std::vector<Graph::VertexType> clique;
     Graph::Coloring heuristic_coloring;
     //use CliSAT binary to get a large clique quickly
     std::vector<Graph::VertexType> external_get_clique(bool write_graph_get_clique);
+    //branch and bound on the current graph in process, used if CliSAT is not available
+    std::vector<Graph::VertexType> internal_get_clique(bool reduced_graph);
     Graph::Permutation graph_vertex_ordering; //store applied permutation
     using SubGraph = std::map<Graph::VertexType, Bitset >; //maps vertex to adjacent vertices
     int mycielsky_extension_lb(SubGraph H) const;
     //function for graph reduction, and flag whether it was successful
     bool has_removed_vertices_in_reduction = false;
+    //clique-based fusions or edges were applied, the reduced graph only keeps whether it is k-colorable for SingleK
+    bool has_clique_based_reductions = false;
     bool reduced_graph();
     //higher level preprocessing functions
     void preprocessing_clique_bound(bool write_new_graph_and_get_clique = false);
     void preprocessing_mycielsky_bound();
     void preprocessing_reductions();
     void preprocessing_initial_coloring();
+    void preprocessing_local_search();
     void preprocessing_clique_ordering();
+    //lower bounds from a core subgraph around the clique, solved with the zykov propagator for k = lower_bound and
+    //grown by the vertices a coloring of the core can't be extended to, until the bound lifts or the coloring extends
+    void preprocessing_core_lower_bound();
+    //throws SearchStopped once the deadline is reached
+    bool solve_core(const Graph::NeighborList &neighbors, const std::vector<Graph::VertexType> &core, int num_colors,
+                    ColorMap &core_coloring, std::chrono::steady_clock::time_point deadline);
+    std::vector<Graph::VertexType> extend_core_coloring(const Graph::NeighborList &neighbors, ColorMap &colors,
+                                                        int num_colors) const;
 
     int initial_fractional_timeout = 10;
     bool flag_fractional_timed_out = false;
-    int external_get_fractional();
+    int external_get_fractional(bool write_graph);
+
+    //with multiple threads, the mycielski and fractional bounds are computed concurrently to the other preprocessing
+    //steps, their results are collected between the phases and the tasks are cancelled once lb == ub
+    std::future<std::pair<int, Duration>> mycielsky_task;
+    std::future<int> fractional_task;
+    std::atomic<bool> cancel_preprocessing = false;
+    void start_concurrent_bounds();
+    void collect_concurrent_bounds(bool wait);
+    bool check_solved_in_preprocessing();
 
 
     //collected notification and print functions for lb/ub updates or other related cases
@@ -192,15 +257,60 @@ private:
     //functions to obtain coloring from SAT solution of zykov encoding
     int get_num_colors_from_model() const;
     ColorMap obtain_coloring_from_model() const;
-    //write optimal or best found coloring to dimacs file, undoes preprocessing steps too
+    //returns optimal or best found coloring of the input graph, undoes preprocessing steps too
+    Graph::Coloring recover_optimal_coloring();
+    //write optimal or best found coloring to dimacs file
     void write_optimal_coloring();
 
+    //decomposition of the graph into its blocks, i.e., the pieces separated by cut vertices
+    //the chromatic number is the maximum over all pieces, and their colorings are glued together at the cut vertices
+    struct GraphPiece {
+        std::vector<Graph::VertexType> vertices; //sorted vertices of the piece
+        Graph::Graph graph; //subgraph induced by the piece, with vertices relabeled by their position
+    };
+    std::vector<GraphPiece> decompose_graph() const;
+    //solves every piece with its own instance, in parallel if more threads are given, returns false if not decomposable
+    bool solve_by_decomposition();
+    //used for pieces, runs preprocessing and the algorithm without writing results
+    int solve_subproblem();
+
+    //hybrid strategy: a top-down and a bottom-up instance on the current graph run in two threads and share their
+    //bounds, the terminator stops the SAT call of one once the other settled the chromatic number
+    struct SharedBounds : public CaDiCaL::Terminator {
+        SharedBounds(int lb, int ub, ColorMap best_coloring)
+            : lower_bound(lb), upper_bound(ub), coloring(std::move(best_coloring)) {}
+        bool terminate() override {
+            return stop or lower_bound >= upper_bound or std::chrono::steady_clock::now() >= deadline;
+        }
+        std::mutex mutex; //guards the coloring and updates of the bounds
+        std::atomic<int> lower_bound;
+        std::atomic<int> upper_bound;
+        ColorMap coloring; //coloring with upper_bound colors
+        std::atomic<bool> stop = false; //set if one of the searches failed
+        //end of the time budget, only used for the core subgraphs in preprocessing
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+        Options::SearchStrategy settled_by = Options::Hybrid;
+    };
+    //thrown by run_solver when its SAT call was stopped through the shared bounds or their deadline
+    struct SearchStopped {};
+    SharedBounds *shared_bounds = nullptr;
+    int hybrid_search();
+    //exchanges the bounds with the other search, called whenever the search loops reach a new k
+    void share_bounds();
+
     // functions that cover the single-k, top-down and bottom-up approach both for the assignment encoding and the partial order encoding
+    int direct_encoding_num_colors = 0; //number of colors the current direct encoding was built with
     void build_direct_encoding(int num_colors);
     bool direct_encoding_single_k();
     int direct_encoding_top_down();
     void direct_encoding_top_down_fix_variables(int full_num_colors, int colors); //helper function in top-down solving
     int direct_encoding_bottom_up();
+    //bisection solves the k chosen by bisection_num_colors until the bounds meet, found colorings lower the upper bound
+    int direct_encoding_bisection();
+    [[nodiscard]] int bisection_num_colors(int gallop_step) const;
+    //adds guards that restrict the encoding to fewer colors under assumptions, used in incremental bottom-up solving
+    void add_direct_encoding_color_guards(int num_colors);
+    int direct_encoding_first_guard = -1; //variable index of the first guard
 
     //functions for using the assignment encoding for the graph coloring problem
     int do_assignment_encoding();
@@ -209,6 +319,17 @@ private:
     int assignment_encoding_top_down();
     int assignment_encoding_bottom_up();
 
+    //at-most-one constraint on the given literals, in the encoding chosen by the options
+    void add_at_most_one(const std::vector<Lit> &literals);
+    void add_pairwise_amo(const std::vector<Lit> &literals);
+    void add_sequential_amo(const std::vector<Lit> &literals);
+    void add_product_amo(const std::vector<Lit> &literals);
+    void add_commander_amo(const std::vector<Lit> &literals);
+    //symmetry breaking of the assignment and partial order encoding, the color classes are ordered by their first vertex
+    void add_color_ordering(int num_colors);
+    //vertex order of the color ordering, the fixed clique vertices first and then the others by index
+    [[nodiscard]] std::vector<int> color_ordering_vertex_order() const;
+
     //functions for using the partial order encoding for the graph coloring problem
     int do_partial_order_encoding();
     void build_partial_order_encoding(int num_colors);
@@ -218,16 +339,27 @@ private:
 
     //functions for full encoding MaxSAT formulation
     void write_full_maxsat_encoding();
-    void write_transitivity(int &count_clauses, int i, int j, int k);
-    void write_all_transitivity(int &count_clauses);
-    void write_cj_definition(int &count_clauses);
+    void write_all_transitivity(ClauseWriter &wcnf);
+    void write_cj_definition(ClauseWriter &wcnf);
 
     // functions to initialise var indices, and building the zykov encoding + the color counting c_j + at most k
     void initialise_variable_indices(int start_index = 0);
+    //throws if the s_ij and c_j don't fit into the int variables of the SAT solver
+    void check_zykov_variable_range(int start_index, long long num_sij) const;
     inline void add_transitivity(int i, int j, int k);
     void add_all_transitivity();
+    //generates the transitivity clauses of all triples on --threads workers and hands them to consume in chunks,
+    //as dimacs literals (indices shifted by literal_offset) with each clause terminated by 0
+    void stream_transitivity_clauses(int literal_offset,
+                                     const std::function<void(const std::vector<int> &)> &consume) const;
     void add_cj_definition();
     void add_zykov_encoding();
+    //probes every s_ij at the root: if merging i,j or separating them gives a clique or mycielski bound above
+    //num_colors, the other choice is added as unit clause. the units stay valid for fewer colors, so they are kept
+    //and added again when the encoding is rebuilt
+    void probe_sij_variables(int num_colors);
+    bool has_probed_sij = false;
+    std::vector<Lit> probing_units;
     void add_at_most_k(int k);
     void add_incremental_at_most_k(int k);
 
@@ -236,6 +368,7 @@ private:
     bool zykov_encoding_single_k();
     int zykov_encoding_top_down();
     int zykov_encoding_bottom_up();
+    int zykov_encoding_bisection();
 
     //functions for using the full zykov encoding. They just call the zykov_encoding_... functions
     int do_full_encoding();
@@ -254,10 +387,33 @@ private:
     //different methods to find existing conflicts
     ConflictList find_conflicts() const;
     ConflictList find_conflicts_naive() const;
-    Graph::NeighborList get_pairing_graph(const Model &model) const;
     ConflictList find_conflicts_sparse_triangles() const;
     ConflictList find_conflicts_all_triangles() const;
     ConflictList find_conflicts_paper() const;
+    //triangle checkers on bitset rows of the pairing graph, vertices are split across the threads in chunks
+    //and the conflicts are merged in vertex order, so the result does not depend on the number of threads
+    ConflictList find_triangle_conflicts(bool one_per_vertex) const;
+    //reads the s_ij from the solver into sij_values and sets up the pairing graph as rows of 64 bit words
+    void read_sij_values() const;
+    void build_pairing_rows() const;
+    [[nodiscard]] bool is_paired(int i, int j) const {
+        return (pairing_rows[static_cast<std::size_t>(i) * pairing_row_words + j / 64] >> (j % 64)) & 1U;
+    }
+    mutable std::vector<std::uint64_t> pairing_rows;
+    mutable std::size_t pairing_row_words = 0;
+    //groups vertices into components of true s_ij with a union-find and checks that every component is consistent,
+    //the buffers are kept between the cegar iterations
+    ConflictList find_conflicts_union_find() const;
+    mutable Bitset sij_values; //value of each s_ij variable in the current model
+    mutable std::vector<int> component_parent; //union-find forest, later the parent in a spanning tree of the component
+    mutable std::vector<int> component_size;
+    mutable std::vector<int> component_root;
+    mutable std::vector<int> tree_depth;
+    mutable std::vector<int> tree_edges; //pairs of vertices whose s_ij merged two components
+    mutable std::vector<int> tree_adjacency_start, tree_adjacency, bfs_queue;
+    mutable std::vector<int> path_from_u, path_from_v;
+    [[nodiscard]] int find_component(int v) const;
+    [[nodiscard]] bool sij_value(int i, int j) const;
     void add_conflict_clauses(const ConflictList &conflicts);
 
 
@@ -265,6 +421,9 @@ private:
     // for zykov encoding
     friend class CadicalZykovPropagator;
     std::unique_ptr<CadicalZykovPropagator> zykov_propagator;
+    //coloring found by the heuristic in the propagator, the SAT call is stopped and it is used instead of the model
+    ColorMap search_coloring;
+    ColorMap obtain_zykov_coloring();
 
     int do_zykov_propagator();
     void init_zykov_propagator();
@@ -272,6 +431,13 @@ private:
     int zykov_propagator_top_down();
     int zykov_propagator_bottom_up();
 
+    //assignment encoding whose different-color and at-most-one constraints are handled by a propagator,
+    // it is solved with the direct_encoding_... functions
+    friend class CadicalAssignmentPropagator;
+    std::unique_ptr<CadicalAssignmentPropagator> assignment_propagator;
+    int do_assignment_propagator();
+    void init_assignment_propagator(int num_colors);
+
     // function that runs cegar algorithm in a configuration as close a as possible to original paper
     int original_paper_configuration();
 
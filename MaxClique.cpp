@@ -0,0 +1,162 @@
+#include "MaxClique.h"
+
+
+MaxClique::MaxClique(const std::vector<Bitset> &adjacency) {
+    n = static_cast<int>(adjacency.size());
+    compute_ordering(adjacency);
+    //renumber the matrix so that bitset order equals the vertex ordering
+    adj = std::vector<Bitset>(n, Bitset(n));
+    for (int v = 0; v < n; ++v) {
+        assert(static_cast<int>(adjacency[v].size()) == n);
+        for (auto w = adjacency[v].find_first(); w != Bitset::npos; w = adjacency[v].find_next(w)) {
+            if (static_cast<int>(w) != v) {
+                adj[position[v]].set(position[w]);
+            }
+        }
+    }
+}
+
+void MaxClique::compute_ordering(const std::vector<Bitset> &adjacency) {
+    //degeneracy ordering: repeatedly remove a vertex of minimum degree, the vertices removed last form the densest core
+    //and get the smallest indices, so they are colored first and branched on last
+    order.assign(n, 0);
+    position.assign(n, 0);
+    std::vector<int> degree(n);
+    for (int v = 0; v < n; ++v) {
+        degree[v] = static_cast<int>(adjacency[v].count()) - (adjacency[v].test(v) ? 1 : 0);
+    }
+    Bitset remaining(n);
+    remaining.set();
+    for (int i = n - 1; i >= 0; --i) {
+        int min_vertex = -1;
+        for (auto v = remaining.find_first(); v != Bitset::npos; v = remaining.find_next(v)) {
+            if (min_vertex == -1 or degree[v] < degree[min_vertex]) {
+                min_vertex = static_cast<int>(v);
+            }
+        }
+        remaining.reset(min_vertex);
+        order[i] = min_vertex;
+        position[min_vertex] = i;
+        Bitset neighbors = adjacency[min_vertex] & remaining;
+        for (auto w = neighbors.find_first(); w != Bitset::npos; w = neighbors.find_next(w)) {
+            degree[w]--;
+        }
+    }
+}
+
+std::vector<int> MaxClique::solve(const double time_limit, const long long node_limit,
+                                  const std::vector<int> &initial_clique) {
+    num_nodes = 0;
+    max_nodes = node_limit;
+    use_time_limit = time_limit >= 0;
+    if (use_time_limit) {
+        deadline = std::chrono::steady_clock::now() +
+                   std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(time_limit));
+    }
+    aborted = false;
+    current_clique.clear();
+    best_clique.clear();
+
+    //only use the given clique if it is still a clique in this graph
+    for (int v : initial_clique) {
+        int pos = position[v];
+        bool adjacent_to_all = true;
+        for (int w : best_clique) {
+            adjacent_to_all = adjacent_to_all and adj[pos][w];
+        }
+        if (not adjacent_to_all) {
+            best_clique.clear();
+            break;
+        }
+        best_clique.push_back(pos);
+    }
+    //greedy clique along the ordering as a first incumbent
+    std::vector<int> greedy;
+    Bitset candidates(n);
+    candidates.set();
+    while (candidates.any()) {
+        auto v = static_cast<int>(candidates.find_first());
+        greedy.push_back(v);
+        candidates &= adj[v];
+    }
+    if (greedy.size() > best_clique.size()) {
+        best_clique = greedy;
+    }
+
+    if (n > 0) {
+        candidates.set();
+        expand(candidates);
+    }
+    optimal = not aborted;
+
+    std::vector<int> result;
+    result.reserve(best_clique.size());
+    for (int v : best_clique) {
+        result.push_back(order[v]);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+bool MaxClique::budget_exhausted() {
+    if (aborted) return true;
+    if (max_nodes >= 0 and num_nodes > max_nodes) {
+        aborted = true;
+    }
+    //checking the clock is comparatively expensive, so only do it every few nodes
+    else if (use_time_limit and (num_nodes & 1023) == 0 and std::chrono::steady_clock::now() > deadline) {
+        aborted = true;
+    }
+    return aborted;
+}
+
+void MaxClique::color_sort(const Bitset &candidates, const int min_color, std::vector<int> &vertices,
+                           std::vector<int> &colors) const {
+    vertices.clear();
+    colors.clear();
+    Bitset uncolored = candidates;
+    Bitset color_class(n);
+    int color = 0;
+    while (uncolored.any()) {
+        color++;
+        color_class = uncolored;
+        //take first vertex of the color class and remove its neighbors, until no vertex can be added
+        for (auto v = color_class.find_first(); v != Bitset::npos; v = color_class.find_next(v)) {
+            uncolored.reset(v);
+            color_class -= adj[v];
+            //vertices with small colors can never lead to a larger clique and are not branched on
+            if (color >= min_color) {
+                vertices.push_back(static_cast<int>(v));
+                colors.push_back(color);
+            }
+        }
+    }
+}
+
+void MaxClique::expand(Bitset candidates) {
+    num_nodes++;
+    if (budget_exhausted()) return;
+
+    std::vector<int> vertices;
+    std::vector<int> colors;
+    int min_color = static_cast<int>(best_clique.size()) - static_cast<int>(current_clique.size()) + 1;
+    color_sort(candidates, std::max(min_color, 1), vertices, colors);
+
+    //branch in reverse order, so the vertices with the largest color bound are tried first
+    for (int i = static_cast<int>(vertices.size()) - 1; i >= 0; --i) {
+        if (static_cast<int>(current_clique.size()) + colors[i] <= static_cast<int>(best_clique.size())) return;
+        int v = vertices[i];
+        current_clique.push_back(v);
+        Bitset new_candidates = candidates & adj[v];
+        if (new_candidates.none()) {
+            if (current_clique.size() > best_clique.size()) {
+                best_clique = current_clique;
+            }
+        } else {
+            expand(new_candidates);
+        }
+        current_clique.pop_back();
+        if (aborted) return;
+        candidates.reset(v);
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef INCSATGC_MAXCLIQUE_H
+#define INCSATGC_MAXCLIQUE_H
+
+#include <vector>
+#include <chrono>
+#include <cassert>
+#include <algorithm>
+
+#include "boost/dynamic_bitset.hpp"
+
+using Bitset = boost::dynamic_bitset<>;
+
+//exact maximum clique solver working on a bitset adjacency matrix, so it can be run in process instead of CliSAT
+//branch and bound in the style of BBMC: vertices are renumbered by a degeneracy ordering and every node is bounded
+//by a greedy sequential coloring of its candidate set, the search stops early once the time or node budget is used up
+class MaxClique {
+public:
+    explicit MaxClique(const std::vector<Bitset> &adjacency);
+
+    //returns the largest clique found, initial_clique can be given as a starting incumbent
+    //negative limits mean no limit
+    std::vector<int> solve(double time_limit = -1, long long node_limit = -1,
+                           const std::vector<int> &initial_clique = {});
+
+    //true if the last call to solve finished within its budget, i.e. the returned clique is maximum
+    [[nodiscard]] bool is_optimal() const { return optimal; }
+    [[nodiscard]] long long get_num_nodes() const { return num_nodes; }
+
+private:
+    int n;
+    std::vector<Bitset> adj; //adjacency in the new vertex ordering
+    std::vector<int> order; //new index -> original vertex
+    std::vector<int> position; //original vertex -> new index
+
+    std::vector<int> current_clique;
+    std::vector<int> best_clique;
+    long long num_nodes = 0;
+    long long max_nodes = -1;
+    bool use_time_limit = false;
+    std::chrono::steady_clock::time_point deadline;
+    bool aborted = false;
+    bool optimal = false;
+
+    void compute_ordering(const std::vector<Bitset> &adjacency);
+    void expand(Bitset candidates);
+    //greedy coloring of the candidates, only vertices with color at least min_color are returned together with their color
+    void color_sort(const Bitset &candidates, int min_color, std::vector<int> &vertices, std::vector<int> &colors) const;
+    bool budget_exhausted();
+};
+
+
+#endif //INCSATGC_MAXCLIQUE_H
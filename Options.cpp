@@ -9,13 +9,20 @@ Options::Options() {
     verbosity = Normal;
     disable_preprocessing = false;
     reduce_graph = false;
+    extended_reductions = false;
     use_clique_in_ordering = false;
     use_mycielsky_lb = false;
     remove_trivial_cj = false;
     assignment_encoding_amo = false;
+    amo_encoding = PairwiseAMO;
+    color_ordering = false;
     write_cnf_only = false;
+    compress_output = false;
     zykov_propagator_decision_strategy = CadicalZykov;
     disable_cardinality_constraints = false;
+    propagate_cardinality_constraints = false;
+    probe_sij_variables = false;
+    probing_time_limit = 1.0;
     zykov_coloring_algorithm = None;
     prop_clique_limit = std::numeric_limits<int>::max();
     use_clique_explanation_clauses = false;
@@ -33,6 +40,14 @@ Options::Options() {
     mnts_depth = 25;
     use_fractional_bound = false;
     frac_density = 1.0;
+    decompose_graph = false;
+    core_lower_bound = false;
+    core_time_limit = 10.0;
+    num_threads = 1;
+    internal_clique_solver = false;
+    clique_time_limit = 1.0;
+    local_search_time = 0.0;
+    phase_from_coloring = false;
 }
 
 Options::Options(int argc, char **argv) : Options() {
@@ -68,22 +83,44 @@ Options::Options(int argc, char **argv) : Options() {
                     "Disable preprocessing and initial bounds")
             ("reduce-graph,r", po::bool_switch(&reduce_graph),
                     "Enable removing vertices in preprocessing")
+            ("extended-reductions", po::bool_switch(&extended_reductions),
+                    "Also use twin, simplicial, crown and clique-based reductions in preprocessing (requires -r)")
             ("use-clique,o", po::bool_switch(&use_clique_in_ordering),
                     "Enable fixing the first vertices of a clique")
+            ("internal-clique", po::bool_switch(&internal_clique_solver),
+                    "Compute the initial clique in process even if the CliSAT binary is available")
+            ("clique-time", po::value(&clique_time_limit),
+                    "Time limit in seconds for the in-process clique search (default 1)")
+            ("tabu-time", po::value(&local_search_time),
+                    "Time in seconds for tabu search improving the initial coloring, uses all threads (disabled/0 by default)")
+            ("phase-from-coloring", po::bool_switch(&phase_from_coloring),
+                    "Use the best known coloring as initial phases of the variables in each SAT call (CaDiCaL only)")
             ("mycielski-bound,m", po::bool_switch(&use_mycielsky_lb),
                     "Compute initial mycielski lower bound ")
             ("remove-cj", po::bool_switch(&remove_trivial_cj),
                     "Removes some of the literals from the cardinality constraints if possible")
             ("assignment-amo", po::bool_switch(&assignment_encoding_amo),
                     "Uses at-most-one color clauses for assignment encoding")
+            ("amo-encoding", po::value<int>((int*)&amo_encoding),
+                    option_description("Set encoding of the at-most-one color clauses", tostr_amo_encoding).c_str())
+            ("color-ordering", po::bool_switch(&color_ordering),
+                    "Orders the color classes by their smallest vertex in the assignment and partial order encodings")
 
             ("write-cnf-only", po::bool_switch(&write_cnf_only),
                     "Option to build but only write cnf to file and not solve (works for -s 2)")
+            ("compress-output", po::bool_switch(&compress_output),
+                    "Writes the cnf of --write-cnf-only or the wcnf of the Full MaxSAT encoding gzip compressed")
 
             ("zykov-strategy", po::value<int>((int*)&zykov_propagator_decision_strategy),
                     option_description("Options for decision strategy in Zykov propagator", tostr_zykov_strategy).c_str())
             ("disable-cardinality", po::bool_switch(&disable_cardinality_constraints),
                     "Options to disable cardinality constraints and only use cliques to assert coloring size")
+            ("propagate-cardinality", po::bool_switch(&propagate_cardinality_constraints),
+                    "Propagates the at most k constraint on the c_j in the Zykov propagator instead of encoding it")
+            ("probe-sij", po::bool_switch(&probe_sij_variables),
+                    "Fixes s_ij before the search if merging or separating i,j gives a clique or mycielski bound above k")
+            ("probe-time", po::value(&probing_time_limit),
+                    "Time limit in seconds for probing the s_ij, uses all threads (default 1)")
             ("coloring-algorithm", po::value<int>((int*)&zykov_coloring_algorithm),
                     option_description("Options for coloring algorithm used in Zykov search tree", tostr_color_algorithm).c_str())
 
@@ -102,7 +139,7 @@ Options::Options(int argc, char **argv) : Options() {
             ("negative-pruning", po::bool_switch(&enable_negative_pruning),
             "enables clique-based negative pruning in Zykov propagator")
             ("non-incremental-solving", po::bool_switch(&non_incremental_solving),
-            "disables incremental bottom up solving of Zykov propagator")
+            "disables incremental bottom up solving of Zykov propagator and the assignment and partial order encodings")
 
 
             ("original-paper-configuration", po::bool_switch(&original_paper_configuration),
@@ -132,6 +169,15 @@ Options::Options(int argc, char **argv) : Options() {
 
             ("frac-density", po::value(&frac_density),
             "Density threshold for fractional bound computation")
+
+            ("decompose", po::bool_switch(&decompose_graph),
+            "Solves the blocks (pieces separated by cut vertices) of the graph separately after preprocessing")
+            ("core-lb", po::bool_switch(&core_lower_bound),
+            "Raises the lower bound in preprocessing by solving growing core subgraphs with the Zykov propagator")
+            ("core-time", po::value(&core_time_limit),
+            "Time limit in seconds for all core subgraphs of --core-lb together (default 10)")
+            ("threads,j", po::value(&num_threads),
+            "Number of threads used in parallel parts of the algorithm (default = 1)")
         ;
 
     //parse positional option which is the filename
@@ -243,6 +289,9 @@ Options::Options(int argc, char **argv) : Options() {
             throw po::error("Cannot have pre-processing disabled and use graph reduction.");
         }
     }
+    if(extended_reductions and not reduce_graph){
+        throw po::error("Extended reductions require graph reduction to be enabled.");
+    }
 
     //if option for specific number of colors is set, also check that a number of colors is given
     if (vm.count("strategy") && strategy == Options::SingleK){
@@ -292,15 +341,16 @@ Options::Options(int argc, char **argv) : Options() {
 
     //check that options are within range
     if( not(
-            (Encoding::AssignmentEncoding <= encoding and encoding <= Encoding::ZykovPropagator) and
-            (CheckAlgorithm::NaiveChecker <= checker and checker <= CheckAlgorithm::PaperChecker) and
-            (SearchStrategy::TopDown <= strategy and strategy <= SearchStrategy::SingleK) and
+            (Encoding::AssignmentEncoding <= encoding and encoding <= Encoding::AssignmentPropagator) and
+            (CheckAlgorithm::NaiveChecker <= checker and checker <= CheckAlgorithm::UnionFindChecker) and
+            (SearchStrategy::TopDown <= strategy and strategy <= SearchStrategy::Bisection) and
             (Solver::Glucose <= solver and solver <= Solver::CaDiCaL) and
             (Verbosity::Quiet <= verbosity and verbosity <= Verbosity::Debug) and
             (ZykovPropagatorDecisionStrategy::CadicalZykov <= zykov_propagator_decision_strategy and
                 zykov_propagator_decision_strategy <= ZykovPropagatorDecisionStrategy::BagSize) and
             (ZykovPropagatorColoringAlgorithm::None <= zykov_coloring_algorithm and
-                zykov_coloring_algorithm <= ZykovPropagatorColoringAlgorithm::IteratedSEQ)
+                zykov_coloring_algorithm <= ZykovPropagatorColoringAlgorithm::IteratedSEQ) and
+            (AMOEncoding::PairwiseAMO <= amo_encoding and amo_encoding <= AMOEncoding::CommanderAMO)
             )){
         throw po::error("Option was out of range.");
     }
@@ -321,18 +371,81 @@ Options::Options(int argc, char **argv) : Options() {
         }
     }
 
+    if(encoding == AssignmentPropagator) {
+        if (solver != CaDiCaL) {
+            throw std::runtime_error("Propagators are only supported by Cadical");
+        }
+        if(use_mycielsky_explanation_clauses and not use_clique_explanation_clauses) {
+            throw std::runtime_error("Mycielski explanations only work with clique explanations");
+        }
+        if(enable_positive_pruning or enable_negative_pruning or use_dominated_vertex_decisions
+            or use_fractional_bound or zykov_coloring_algorithm != None) {
+            throw po::error("The assignment propagator only supports clique and mycielski explanations.");
+        }
+        if(write_cnf_only) {
+            throw po::error("The assignment propagator does not build a complete cnf to write.");
+        }
+    }
+
     if(encoding == ZykovPropagator and disable_cardinality_constraints and not use_clique_explanation_clauses) {
         throw po::error("Cannot disable cardinality encodign without using clique explanations");
     }
+    if(propagate_cardinality_constraints and (encoding != ZykovPropagator or disable_cardinality_constraints)) {
+        throw po::error("Propagating the cardinality constraints needs the Zykov propagator with cardinality constraints.");
+    }
 
 
     if(mycielsky_threshold < 0 or prop_clique_limit < 0){
         throw po::error("mycielski_threshold or prop_clique_limit can't be negative");
     }
 
-    if(zykov_coloring_algorithm != None or enable_detailed_backtracking_stats) {
-        std::cout << "Warning: options of coloring heuristic during propagator and detailed backtracking statistics are only for testing.\n";
-        if(enable_detailed_backtracking_stats and stats_csvfile.empty()) {
+    if(clique_time_limit < 0 or local_search_time < 0 or probing_time_limit < 0 or core_time_limit < 0){
+        throw po::error("Time limits of clique search, tabu search, probing and core bounds can't be negative.");
+    }
+    if(probe_sij_variables and not (encoding == FullEncoding or encoding == CEGAR or encoding == ZykovPropagator)) {
+        throw po::error("Probing of the s_ij only works with the Zykov encodings.");
+    }
+
+    if(num_threads < 1){
+        throw po::error("Number of threads has to be at least 1.");
+    }
+    if(compress_output and not write_cnf_only and encoding != FullMaxSAT) {
+        throw po::error("Compressed output is only written with --write-cnf-only or the Full MaxSAT encoding.");
+    }
+    if(compress_output and write_cnf_only and encoding != FullMaxSAT and solver != CaDiCaL) {
+        throw po::error("Compressed cnf output is only supported with CaDiCaL.");
+    }
+    if(phase_from_coloring and (solver != CaDiCaL or encoding == FullMaxSAT)) {
+        throw po::error("Phases from the best coloring can only be set for the CaDiCaL solver.");
+    }
+
+    //the hybrid strategy stops the SAT call of one search through the cadical terminator
+    if(strategy == Hybrid and (solver != CaDiCaL or write_cnf_only)) {
+        throw po::error("The hybrid strategy needs CaDiCaL and can't only write the cnf.");
+    }
+
+    //bisection changes k in both directions, which needs the color guards of the direct encodings
+    //or the zykov propagator to handle the bound instead of the cardinality encoding
+    if(strategy == Bisection and not (encoding == AssignmentEncoding or encoding == PartialOrderEncoding
+            or encoding == AssignmentPropagator or (encoding == ZykovPropagator
+                and (propagate_cardinality_constraints or disable_cardinality_constraints)))) {
+        throw po::error("Bisection needs a direct encoding or the Zykov propagator with propagated or disabled cardinality.");
+    }
+    if(strategy == Bisection and (write_cnf_only or non_incremental_solving)) {
+        throw po::error("Bisection only works with incremental solving.");
+    }
+
+    if(decompose_graph and (disable_preprocessing or strategy == SingleK or encoding == FullMaxSAT
+                            or write_cnf_only or original_paper_configuration)){
+        throw po::error("Graph decomposition needs preprocessing and a top-down or bottom-up search.");
+    }
+    if(core_lower_bound and (disable_preprocessing or solver != CaDiCaL)) {
+        throw po::error("Core lower bounds are computed in preprocessing and need the propagator of CaDiCaL.");
+    }
+
+    if(enable_detailed_backtracking_stats) {
+        std::cout << "Warning: detailed backtracking statistics are only for testing.\n";
+        if(stats_csvfile.empty()) {
             throw po::error("Only enable detailed backtracking stats if also writing stats to csv file.");
         }
     }
@@ -357,14 +470,47 @@ void Options::print() const {
     }
     std::cout << "c Options : Preprocessing           = " << (not disable_preprocessing ? "True" : "False") << "\n";
     std::cout << "c Options : Graph reduction         = " << (reduce_graph ? "True" : "False") << "\n";
+    if(reduce_graph) {
+    std::cout << "c Options : Extended reductions     = " << (extended_reductions ? "True" : "False") << "\n";
+    }
+    std::cout << "c Options : In-process clique       = " << (internal_clique_solver ? "True" : "False") << "\n";
     std::cout << "c Options : Use clique in ordering  = " << (use_clique_in_ordering ? "True" : "False") << "\n";
     std::cout << "c Options : Use mycielski bound     = " << (use_mycielsky_lb ? "True" : "False") << "\n";
     std::cout << "c Options : Remove trivial cj       = " << (remove_trivial_cj ? "True" : "False") << "\n";
+    std::cout << "c Options : Tabu search time        = " << local_search_time << "\n";
+    std::cout << "c Options : Phases from coloring    = " << (phase_from_coloring ? "True" : "False") << "\n";
+    std::cout << "c Options : Decompose graph         = " << (decompose_graph ? "True" : "False") << "\n";
+    std::cout << "c Options : Core lower bound        = " << (core_lower_bound ? "True" : "False") << "\n";
+    if(core_lower_bound) {
+    std::cout << "c Options : Core time               = " << core_time_limit << "\n";
+    }
+    std::cout << "c Options : Threads                 = " << num_threads << "\n";
+    if(encoding == FullEncoding or encoding == CEGAR or encoding == ZykovPropagator) {
+    std::cout << "c Options : Probe s_ij              = " << (probe_sij_variables ? "True" : "False") << "\n";
+    }
+    if(write_cnf_only or encoding == FullMaxSAT) {
+    std::cout << "c Options : Compress output         = " << (compress_output ? "True" : "False") << "\n";
+    }
     if(encoding == AssignmentEncoding) {
     std::cout << "c Options : Assignment at-most-one  = " << (assignment_encoding_amo ? "True" : "False") << "\n";
     }
+    if(encoding == AssignmentEncoding and assignment_encoding_amo) {
+    std::cout << "c Options : At-most-one encoding    = " << tostr_amo_encoding[amo_encoding] << "\n";
+    }
+    if(encoding == AssignmentEncoding or encoding == PartialOrderEncoding or encoding == AssignmentPropagator) {
+    std::cout << "c Options : Color class ordering    = " << (color_ordering ? "True" : "False") << "\n";
+    }
+    if((encoding == AssignmentEncoding or encoding == PartialOrderEncoding or encoding == AssignmentPropagator)
+        and (strategy == BottomUp or strategy == Hybrid)) {
+    std::cout << "c Options : No incremental bottom-up= " << (non_incremental_solving ? "True" : "False") << "\n";
+    }
+    if(encoding == AssignmentPropagator) {
+    std::cout << "c Options : Use clique bounding     = " << (use_clique_explanation_clauses ? "True" : "False") << "\n";
+    std::cout << "c Options : Use mycielski bounding  = " << (use_mycielsky_explanation_clauses ? "True" : "False") << "\n";
+    }
     if(encoding == ZykovPropagator) {
     std::cout << "c Options : Zykov decision strategy = " << tostr_zykov_strategy[zykov_propagator_decision_strategy] << "\n";
+    std::cout << "c Options : Propagate cardinality   = " << (propagate_cardinality_constraints ? "True" : "False") << "\n";
     }
     if(encoding == ZykovPropagator) {
     std::cout << "c Options : Use clique bounding     = " << (use_clique_explanation_clauses ? "True" : "False") << "\n";
@@ -11,23 +11,23 @@ namespace po = boost::program_options;
 struct Options {
     //definition of all enums and corresponding names as static members of the struct
     enum Encoding {
-        AssignmentEncoding, FullMaxSAT, FullEncoding, CEGAR, PartialOrderEncoding, ZykovPropagator
+        AssignmentEncoding, FullMaxSAT, FullEncoding, CEGAR, PartialOrderEncoding, ZykovPropagator, AssignmentPropagator
     };
     inline static const std::vector<std::string> tostr_encoding{
         "Assignment Encoding", "Full MaxSAT", "Full Encoding", "CEGAR", "Partial Order Encoding",
-        "Zykov Encoding Propagator"
+        "Zykov Encoding Propagator", "Assignment Encoding Propagator"
     };
     enum CheckAlgorithm {
-        NaiveChecker, SparseTrianglesChecker, AllTrianglesChecker, PaperChecker
+        NaiveChecker, SparseTrianglesChecker, AllTrianglesChecker, PaperChecker, UnionFindChecker
     };
     inline static const std::vector<std::string> tostr_checker{
-        "Naive Checker", "Sparse Triangles Checker", "All Triangles Checker", "Paper Checker"
+        "Naive Checker", "Sparse Triangles Checker", "All Triangles Checker", "Paper Checker", "Union-Find Checker"
     };
     enum SearchStrategy {
-        TopDown, BottomUp, SingleK
+        TopDown, BottomUp, SingleK, Hybrid, Bisection
     };
     inline static const std::vector<std::string> tostr_strategy{
-        "Top-Down", "Bottom-Up", "Single K"
+        "Top-Down", "Bottom-Up", "Single K", "Hybrid", "Bisection"
     };
     enum Solver {
         Glucose, CaDiCaL
@@ -60,11 +60,30 @@ struct Options {
     std::optional<int> specific_num_colors;
     bool disable_preprocessing;
     bool reduce_graph;
+    bool extended_reductions;
     bool use_clique_in_ordering;
+    //compute cliques with the in-process branch and bound instead of the CliSAT binary, and its time limit
+    bool internal_clique_solver;
+    double clique_time_limit;
+    //time for the tabu search that improves the initial coloring in preprocessing
+    double local_search_time;
+    //set the solver phases from the best known coloring before each SAT call
+    bool phase_from_coloring;
     bool use_mycielsky_lb;
     bool remove_trivial_cj;
     bool assignment_encoding_amo;
+    //how the at-most-one color constraints of the assignment encoding are encoded
+    enum AMOEncoding {
+        PairwiseAMO, SequentialAMO, ProductAMO, CommanderAMO
+    };
+    inline static const std::vector<std::string> tostr_amo_encoding{
+        "Pairwise", "Sequential", "Product", "Commander"
+    };
+    AMOEncoding amo_encoding;
+    //order the color classes by their smallest vertex in the assignment and partial order encodings
+    bool color_ordering;
     bool write_cnf_only;
+    bool compress_output;
     //options for zykov propagator
     enum ZykovPropagatorDecisionStrategy {
         CadicalZykov, FirstLiteral, ISUN, ImitateDsatur, BagSize
@@ -74,6 +93,11 @@ struct Options {
     };
     ZykovPropagatorDecisionStrategy zykov_propagator_decision_strategy;
     bool disable_cardinality_constraints;
+    //count the c_j in the zykov propagator instead of encoding the at most k constraint on them
+    bool propagate_cardinality_constraints;
+    //fix s_ij at the root if merging or separating i and j leads to a clique or mycielski bound above k, and its time limit
+    bool probe_sij_variables;
+    double probing_time_limit;
     enum ZykovPropagatorColoringAlgorithm {
         None, FastDsatur, SortedSEQ, IteratedIS, IteratedSEQ
     };
@@ -108,6 +132,15 @@ struct Options {
     bool use_fractional_bound;
     double frac_density;
 
+    //solve the blocks of the reduced graph separately
+    bool decompose_graph;
+    //prove lower bounds on a small core subgraph with the zykov propagator, grown by the vertices a coloring of it
+    //cannot be extended to, and the time budget of all core solves
+    bool core_lower_bound;
+    double core_time_limit;
+    //number of threads used for the parts of the algorithm that run in parallel
+    int num_threads;
+
 private:
     static std::string enum_names_to_string(const std::vector<std::string>& enum_strings);
     static std::string option_description(std::string desc, const std::vector<std::string> &enum_strings = {});
@@ -0,0 +1,93 @@
+#include "ScratchArena.h"
+
+
+void BitsetList::clear(const int new_bitset_size) {
+    count = 0;
+    bitset_size = new_bitset_size;
+}
+
+Bitset &BitsetList::emplace_back() {
+    if (count == storage.size()) {
+        storage.emplace_back(bitset_size);
+    }
+    Bitset &bitset = storage[count++];
+    if (static_cast<int>(bitset.size()) != bitset_size) {
+        bitset.resize(bitset_size);
+    }
+    bitset.reset();
+    return bitset;
+}
+
+ScratchArena::Frame::Frame(ScratchArena &arena)
+    : arena(arena), bitsets_mark(arena.used_bitsets), ints_mark(arena.used_ints),
+      bitset_lists_mark(arena.used_bitset_lists), int_lists_mark(arena.used_int_lists), words_mark(arena.used_words) {
+}
+
+ScratchArena::Frame::~Frame() {
+    //frames are nested, so everything borrowed after this frame was opened is handed back
+    arena.used_bitsets = bitsets_mark;
+    arena.used_ints = ints_mark;
+    arena.used_bitset_lists = bitset_lists_mark;
+    arena.used_int_lists = int_lists_mark;
+    arena.used_words = words_mark;
+}
+
+Bitset &ScratchArena::Frame::bitset(const int num_bits) {
+    if (arena.used_bitsets == arena.bitsets.size()) {
+        arena.bitsets.emplace_back(num_bits);
+    }
+    Bitset &bitset = arena.bitsets[arena.used_bitsets++];
+    if (static_cast<int>(bitset.size()) != num_bits) {
+        bitset.resize(num_bits);
+    }
+    bitset.reset();
+    return bitset;
+}
+
+std::vector<int> &ScratchArena::Frame::ints(const std::size_t n, const int value) {
+    std::vector<int> &vector = ints();
+    vector.assign(n, value);
+    return vector;
+}
+
+std::vector<int> &ScratchArena::Frame::ints() {
+    if (arena.used_ints == arena.int_vectors.size()) {
+        arena.int_vectors.emplace_back();
+    }
+    std::vector<int> &vector = arena.int_vectors[arena.used_ints++];
+    vector.clear();
+    return vector;
+}
+
+BitsetList &ScratchArena::Frame::bitset_list(const int num_bits) {
+    if (arena.used_bitset_lists == arena.bitset_lists.size()) {
+        arena.bitset_lists.emplace_back();
+    }
+    BitsetList &list = arena.bitset_lists[arena.used_bitset_lists++];
+    list.clear(num_bits);
+    return list;
+}
+
+std::vector<std::vector<int>> &ScratchArena::Frame::int_lists(const std::size_t n) {
+    if (arena.used_int_lists == arena.int_lists.size()) {
+        arena.int_lists.emplace_back();
+    }
+    std::vector<std::vector<int>> &lists = arena.int_lists[arena.used_int_lists++];
+    //only clear the inner vectors, so they keep their capacity
+    if (lists.size() < n) {
+        lists.resize(n);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        lists[i].clear();
+    }
+    return lists;
+}
+
+std::vector<std::uint64_t> &ScratchArena::Frame::words(const std::size_t n) {
+    if (arena.used_words == arena.word_vectors.size()) {
+        arena.word_vectors.emplace_back();
+    }
+    std::vector<std::uint64_t> &vector = arena.word_vectors[arena.used_words++];
+    vector.assign(n, 0);
+    return vector;
+}
@@ -0,0 +1,88 @@
+#ifndef INCSATGC_SCRATCHARENA_H
+#define INCSATGC_SCRATCHARENA_H
+
+#include <vector>
+#include <deque>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+#include "boost/dynamic_bitset.hpp"
+
+using Bitset = boost::dynamic_bitset<>;
+
+//list of bitsets that keeps the memory of removed bitsets, so it can be refilled without allocating
+//elements are stored in a deque so references stay valid when the list grows
+class BitsetList {
+public:
+    using iterator = std::deque<Bitset>::iterator;
+    using const_iterator = std::deque<Bitset>::const_iterator;
+
+    //empties the list, new elements get bitset_size bits
+    void clear(int new_bitset_size);
+    //appends a bitset with all bits reset
+    Bitset &emplace_back();
+    void pop_back() { assert(count > 0); count--; }
+
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    Bitset &operator[](std::size_t i) { assert(i < count); return storage[i]; }
+    const Bitset &operator[](std::size_t i) const { assert(i < count); return storage[i]; }
+    Bitset &back() { assert(count > 0); return storage[count - 1]; }
+    iterator begin() { return storage.begin(); }
+    iterator end() { return storage.begin() + static_cast<std::ptrdiff_t>(count); }
+    [[nodiscard]] const_iterator begin() const { return storage.begin(); }
+    [[nodiscard]] const_iterator end() const { return storage.begin() + static_cast<std::ptrdiff_t>(count); }
+
+private:
+    std::deque<Bitset> storage;
+    std::size_t count = 0;
+    int bitset_size = 0;
+};
+
+//scratch memory for the bounding and coloring routines that run at every node of the zykov search,
+//bitsets and vectors are borrowed inside a Frame and handed back when it goes out of scope,
+//so after the first calls the routines run without allocating
+class ScratchArena {
+public:
+    class Frame {
+    public:
+        explicit Frame(ScratchArena &arena);
+        ~Frame();
+        Frame(const Frame &) = delete;
+        Frame &operator=(const Frame &) = delete;
+
+        //bitset with num_bits bits, all reset
+        Bitset &bitset(int num_bits);
+        //vector of n times value
+        std::vector<int> &ints(std::size_t n, int value);
+        //empty vector, keeps its capacity from earlier frames
+        std::vector<int> &ints();
+        //empty list of bitsets with num_bits bits
+        BitsetList &bitset_list(int num_bits);
+        //n empty int vectors, the inner vectors keep their capacity
+        std::vector<std::vector<int>> &int_lists(std::size_t n);
+        //n 64 bit words, all zero
+        std::vector<std::uint64_t> &words(std::size_t n);
+
+    private:
+        ScratchArena &arena;
+        std::size_t bitsets_mark, ints_mark, bitset_lists_mark, int_lists_mark, words_mark;
+    };
+
+private:
+    //deques so that borrowed references stay valid when more memory is borrowed
+    std::deque<Bitset> bitsets;
+    std::deque<std::vector<int>> int_vectors;
+    std::deque<BitsetList> bitset_lists;
+    std::deque<std::vector<std::vector<int>>> int_lists;
+    std::deque<std::vector<std::uint64_t>> word_vectors;
+    std::size_t used_bitsets = 0;
+    std::size_t used_ints = 0;
+    std::size_t used_bitset_lists = 0;
+    std::size_t used_int_lists = 0;
+    std::size_t used_words = 0;
+};
+
+
+#endif //INCSATGC_SCRATCHARENA_H
@@ -104,7 +104,8 @@ void Statistics::print_stats() const {
     print_time(PreprocessingMycielsky,      "│ │ - Mycielsky");
     print_time(PreprocessingReductions,     "│ │ - Reductions");
     print_time(PreprocessingInitialColoring,"│ │ - Initial coloring");
-    print_time(PreprocessingFractional,     "│ └ - Fractional bound");
+    print_time(PreprocessingFractional,     "│ │ - Fractional bound");
+    print_time(PreprocessingCore,           "│ └ - Core lower bound");
     print_time(Algorithm,                   "│ ┌ Algorithm");
     print_time(BuildEncoding,               "│ │ - Building encoding");
     print_time(BuildAtMostK,                "│ │ - Building at most k constraints");
@@ -133,6 +134,15 @@ void Statistics::print_stats() const {
                   << num_cegar_iterations << " iterations, taking overall " << duration_of(CEGAR) << "\n";
     }
 
+    if (options.probe_sij_variables){
+        std::cout << "c Stats: Probing fixed " << num_fixed_sij << " of " << num_probed_sij << " probed s_ij\n";
+    }
+
+    if (options.core_lower_bound){
+        std::cout << "c Stats: Core lower bound solved " << num_solved_cores << " cores, the last with "
+                  << core_size << " vertices\n";
+    }
+
     if(options.strategy == Options::SingleK){
         assert(options.specific_num_colors.has_value());
         std::cout << "c Stats: Instance is " << (upper_bound <= options.specific_num_colors ? "SAT" :
@@ -147,7 +157,7 @@ void Statistics::print_stats() const {
             std::cout << "c Stats: Instance has lower bound "<< lower_bound << " and upper bound " << upper_bound << "\n";
         }
     }
-    if(options.encoding != Options::ZykovPropagator) {
+    if(options.encoding != Options::ZykovPropagator and options.encoding != Options::AssignmentPropagator) {
         return;
     }
     if(options.verbosity <= Options::Normal) { //only print these stats as extra information
@@ -169,8 +179,11 @@ void Statistics::print_stats() const {
               << "\npositive prunings " << prop_positive_prunings //<< " history " << truncate(prop_positive_pruning_level)
               << "\nnegative prunings " << prop_negative_prunings //<< " history " << truncate(prop_negative_pruning_level)
               << "\n";
+              if (options.propagate_cardinality_constraints) {
+              std::cout << "cardinality propagations " << prop_num_cardinality_propagations << "\n";
+              }
               if (options.zykov_coloring_algorithm != Options::None) {
-              std::cout << "coloring heuristic time saved " << heuristic_theoretical_time_improvement << "\n";
+              std::cout << "colorings found in search " << prop_num_search_colorings << "\n";
               }
               if (options.verbosity >= Options::Debug or (options.verbosity >= Options::Normal and fractional_bound_success >= 1)) {
                   std::cout << "Fractional bound succ/calls " << fractional_bound_success << "/" << fractional_bound_calls
@@ -192,7 +205,9 @@ void Statistics::write_stats() const {
                "lower bound;" "tt_lb;" "clique bound;" "mycielsky bound;"
                "upper bound;" "tt_ub;" "heuristic bound;"
                "original n;" "original m;" "original d;" "reduced n;" "reduced m;" "reduced d;"
-               "removed smalldegree;" "removed dominated;" "solved in preprocessing;"
+               "removed smalldegree;" "removed dominated;" "removed twins;" "removed simplicial;"
+               "fused vertices;" "added edges;" "solved in preprocessing;"
+               "decomposition pieces;" "solved pieces;"
                "variables;" "clauses;" "s_ij variables;" "cj variables;" "transitivity clauses;"
                "at most k variables;" "at most k clauses;" "removed cj;" "peak memory usage;"
                "cegar iterations;" "conflicts;" "conflicts per iteration;"
@@ -205,7 +220,7 @@ void Statistics::write_stats() const {
                "mycielsky calls;" "mycielsky successes;" "mycielsky levels;"
                "dominated vertex decisions;" "positive prunings;" "positive pruning levels;"
                "negative prunings;" "negative pruning levels;"
-               <<(options.zykov_coloring_algorithm != Options::None ? ";heuristic time improvement" : "")  //optional stats that are not always reported
+               <<(options.zykov_coloring_algorithm != Options::None ? "search colorings;" : "")  //optional stats that are not always reported
                <<(options.enable_detailed_backtracking_stats ? "detailed backtrack stats;" : "")<<
                "fractional calls;" "fractional successes;" "fractional running time;"
                "\n";
@@ -232,7 +247,9 @@ void Statistics::write_stats() const {
             << upper_bound << ";" << tt_upper_bound.count() << ";" << heuristic_bound << ";"
             << std::get<0>(original_graph_size) << ";" << std::get<1>(original_graph_size) << ";" << std::get<2>(original_graph_size) << ";"
             << std::get<0>(reduced_graph_size) << ";" << std::get<1>(reduced_graph_size) << ";" << std::get<2>(reduced_graph_size) << ";"
-            << num_removed_small_degree << ";" << num_removed_dominated << ";" << solved_in_preprocessing << ";"
+            << num_removed_small_degree << ";" << num_removed_dominated << ";" << num_removed_twins << ";"
+            << num_removed_simplicial << ";" << num_fused_vertices << ";" << num_added_edges << ";" << solved_in_preprocessing << ";"
+            << num_decomposition_pieces << ";" << num_solved_pieces << ";"
             << num_vars << ";" << num_clauses << ";" << num_sij_vars << ";" << num_cj_vars << ";" << num_transitivity_clauses << ";"
             << num_vars_at_most_k << ";" << num_clauses_at_most_k << ";" << num_removable_cj << ";" << peakMemUsage() << ";"
             << num_cegar_iterations << ";" << num_total_conflicts << ";" << store_num_conflicts << ";"
@@ -247,7 +264,7 @@ void Statistics::write_stats() const {
             << mycielsky_calls << ";" << mycielsky_sucesses << ";" << truncate(prop_myc_pruning_level) << ";"
             << prop_num_dominated_vertex_decisions << ";" << prop_positive_prunings << ";" << truncate(prop_positive_pruning_level) << ";"
             << prop_negative_prunings << ";" << truncate(prop_negative_pruning_level) << ";"
-            << (options.zykov_coloring_algorithm != Options::None ? std::to_string(heuristic_theoretical_time_improvement.count())+";" : "")
+            << (options.zykov_coloring_algorithm != Options::None ? std::to_string(prop_num_search_colorings)+";" : "")
             << (options.enable_detailed_backtracking_stats? vec2str(prop_detailed_backtrack_list)+";" : "")
             << fractional_bound_calls << ";" << fractional_bound_success << ";" << full_fractional_time << ";"
             << "\n";
@@ -312,7 +329,11 @@ double Statistics::peakMemUsage() {
 }
 
 
+//child process times can be added from concurrently running preprocessing tasks
+static std::mutex child_time_mutex;
+
 void Statistics::add_clique_time(const double time){
+    std::lock_guard<std::mutex> lock(child_time_mutex);
     Duration duration(time);
     //have to increase Total, Preprocessing and PreprocessingClique
     durations.at(static_cast<int>(Total)) += duration;
@@ -320,7 +341,72 @@ void Statistics::add_clique_time(const double time){
     durations.at(static_cast<int>(PreprocessingClique)) += duration;
 }
 
+void Statistics::add_mycielsky_time(const Duration duration) {
+    //the thread already counts in the cpu time of Total and Preprocessing
+    durations.at(static_cast<int>(PreprocessingMycielsky)) += duration;
+}
+
+void Statistics::add_search_stats(const Statistics &search) {
+    for (int phase = BuildEncoding; phase < Total; ++phase) {
+        durations.at(phase) += search.duration_of(static_cast<Phase>(phase));
+    }
+    auto add_elementwise = [](std::vector<int> &to, const std::vector<int> &from) {
+        if (to.size() < from.size()) {
+            to.resize(from.size(), 0);
+        }
+        for (std::size_t i = 0; i < from.size(); ++i) {
+            to[i] += from[i];
+        }
+    };
+    bound_information.insert(bound_information.end(), search.bound_information.begin(), search.bound_information.end());
+    num_probed_sij += search.num_probed_sij;
+    num_fixed_sij += search.num_fixed_sij;
+    //both searches build an encoding, report the larger one
+    num_vars = std::max(num_vars, search.num_vars);
+    num_clauses = std::max(num_clauses, search.num_clauses);
+    num_sij_vars = std::max(num_sij_vars, search.num_sij_vars);
+    num_cj_vars = std::max(num_cj_vars, search.num_cj_vars);
+    num_transitivity_clauses = std::max(num_transitivity_clauses, search.num_transitivity_clauses);
+    num_vars_at_most_k = std::max(num_vars_at_most_k, search.num_vars_at_most_k);
+    num_clauses_at_most_k = std::max(num_clauses_at_most_k, search.num_clauses_at_most_k);
+    num_removable_cj = std::max(num_removable_cj, search.num_removable_cj);
+    num_cegar_iterations += search.num_cegar_iterations;
+    num_total_conflicts += search.num_total_conflicts;
+    store_num_conflicts.insert(store_num_conflicts.end(), search.store_num_conflicts.begin(), search.store_num_conflicts.end());
+
+    prop_max_level = std::max(prop_max_level, search.prop_max_level);
+    prop_num_assignments += search.prop_num_assignments;
+    prop_num_decisions += search.prop_num_decisions;
+    add_elementwise(prop_node_depth_history, search.prop_node_depth_history);
+    prop_num_backtracks += search.prop_num_backtracks;
+    add_elementwise(prop_backtrack_size, search.prop_backtrack_size);
+    prop_detailed_backtrack_list.insert(prop_detailed_backtrack_list.end(), search.prop_detailed_backtrack_list.begin(),
+                                        search.prop_detailed_backtrack_list.end());
+    prop_num_propagations += search.prop_num_propagations;
+    prop_num_reason_clauses += search.prop_num_reason_clauses;
+    prop_num_external_clauses += search.prop_num_external_clauses;
+    prop_num_cardinality_propagations += search.prop_num_cardinality_propagations;
+    prop_num_clique_computations += search.prop_num_clique_computations;
+    prop_num_maximal_cliques_computed += search.prop_num_maximal_cliques_computed;
+    prop_num_tight_cliques_computed += search.prop_num_tight_cliques_computed;
+    prop_num_clique_successes += search.prop_num_clique_successes;
+    add_elementwise(prop_clique_pruning_level, search.prop_clique_pruning_level);
+    add_elementwise(mycielsky_calls, search.mycielsky_calls);
+    add_elementwise(mycielsky_sucesses, search.mycielsky_sucesses);
+    add_elementwise(prop_myc_pruning_level, search.prop_myc_pruning_level);
+    prop_num_dominated_vertex_decisions += search.prop_num_dominated_vertex_decisions;
+    prop_positive_prunings += search.prop_positive_prunings;
+    add_elementwise(prop_positive_pruning_level, search.prop_positive_pruning_level);
+    prop_negative_prunings += search.prop_negative_prunings;
+    add_elementwise(prop_negative_pruning_level, search.prop_negative_pruning_level);
+    prop_num_search_colorings += search.prop_num_search_colorings;
+    fractional_bound_calls += search.fractional_bound_calls;
+    fractional_bound_success += search.fractional_bound_success;
+    full_fractional_time += search.full_fractional_time;
+}
+
 void Statistics::add_fractional_time(const double time){
+    std::lock_guard<std::mutex> lock(child_time_mutex);
     Duration duration(time);
     //have to increase Total, Preprocessing and PreprocessingFractional
     durations.at(static_cast<int>(Total)) += duration;
@@ -7,6 +7,7 @@
 #include <chrono> //time keeping
 #include <ctime> //cputime with clock()
 #include <sys/resource.h> //cputime via resource usage linux
+#include <mutex>
 
 #include "Options.h"  //options struct for different settings of the algorithm
 
@@ -28,6 +29,7 @@ public:
             PreprocessingReductions,
             PreprocessingInitialColoring,
             PreprocessingFractional,
+            PreprocessingCore,
         Algorithm,
             BuildEncoding,
             BuildAtMostK,
@@ -69,6 +71,11 @@ public:
     //extra function to add time from child process used for clique/fractional bound to total times
     void add_clique_time(double time);
     void add_fractional_time(double time);
+    //adds the wall time of the mycielski bound computed on its own thread
+    void add_mycielsky_time(Duration duration);
+    //adds the algorithm times and SAT statistics of a search run by another instance, as in the hybrid strategy
+    //or for the blocks of a decomposed graph
+    void add_search_stats(const Statistics &search);
 
     // #########  all the variables and data points we want to observe and store during the algorithm  ####
 
@@ -89,7 +96,17 @@ public:
     std::tuple<int, int, double> reduced_graph_size;
     int num_removed_small_degree = 0;
     int num_removed_dominated = 0;
+    int num_removed_twins = 0;
+    int num_removed_simplicial = 0;
+    int num_fused_vertices = 0;
+    int num_added_edges = 0;
     bool solved_in_preprocessing = false;
+    int num_decomposition_pieces = 0;
+    int num_probed_sij = 0; //s_ij that were probed before the search, and how many of them were fixed
+    int num_fixed_sij = 0;
+    int num_solved_pieces = 0;
+    int core_size = 0; //size of the last core subgraph and how many of them were solved
+    int num_solved_cores = 0;
 
     //more fine-grained stats about the size of the instance
     int num_vars = 0;
@@ -137,6 +154,7 @@ public:
     long long prop_num_propagations = 0;
     long long prop_num_reason_clauses = 0;
     long long prop_num_external_clauses = 0;
+    long long prop_num_cardinality_propagations = 0; //c_j set to false because num_colors - 1 c_j were true
 
     long long prop_num_clique_computations = 0;
     long long prop_num_maximal_cliques_computed = 0;
@@ -153,12 +171,8 @@ public:
     long long prop_negative_prunings = 0;
     std::vector<int> prop_negative_pruning_level;
 
-    //stats for coloring heuristic success, only interested in how much time could theoretically have been saved
-    bool heuristic_found_coloring = false;
-    //when the improved coloring was found
-    Duration heuristic_coloring_time_point;
-    //how much time would have been saved if stopping when heuristic found coloring
-    Duration heuristic_theoretical_time_improvement = Duration(0);
+    //how often the coloring heuristic in the propagator found a coloring and stopped the SAT call
+    long long prop_num_search_colorings = 0;
 
     int fractional_bound_calls = 0;
     int fractional_bound_success = 0;
@@ -0,0 +1,135 @@
+#include "TabuSearch.h"
+
+
+TabuCol::TabuCol(const Graph::NeighborList &neighbors, const unsigned int seed)
+    : neighbors(neighbors), n(static_cast<int>(neighbors.size())), rng(seed) {
+}
+
+void TabuCol::update_conflicting(const int v, const int k, const std::vector<int> &coloring) {
+    bool in_conflict = adjacent_colors[v * k + coloring[v]] > 0;
+    bool in_list = conflict_position[v] != -1;
+    if (in_conflict and not in_list) {
+        conflict_position[v] = static_cast<int>(conflicting.size());
+        conflicting.push_back(v);
+    } else if (not in_conflict and in_list) {
+        //swap with last element and remove
+        int last = conflicting.back();
+        conflicting[conflict_position[v]] = last;
+        conflict_position[last] = conflict_position[v];
+        conflicting.pop_back();
+        conflict_position[v] = -1;
+    }
+}
+
+bool TabuCol::find_coloring(std::vector<int> &coloring, const int num_colors,
+                            const std::chrono::steady_clock::time_point &deadline,
+                            const std::atomic<int> &best_num_colors) {
+    const int k = num_colors;
+    assert(static_cast<int>(coloring.size()) == n);
+    //with at most one color there are no moves, the graph is colorable iff it has no edges
+    if (k <= 1) {
+        return (k == 1 or n == 0) and std::all_of(neighbors.begin(), neighbors.end(),
+                                                   [](const auto &adjacent) { return adjacent.empty(); });
+    }
+    assert(std::all_of(coloring.begin(), coloring.end(), [k](int c) { return 0 <= c and c < k; }));
+
+    //initialise conflict data for the given coloring
+    adjacent_colors.assign(static_cast<std::size_t>(n) * k, 0);
+    tabu_until.assign(static_cast<std::size_t>(n) * k, 0);
+    conflicting.clear();
+    conflict_position.assign(n, -1);
+    int num_conflicts = 0;
+    for (int v = 0; v < n; ++v) {
+        for (Graph::VertexType w : neighbors[v]) {
+            adjacent_colors[v * k + coloring[w]]++;
+        }
+        num_conflicts += adjacent_colors[v * k + coloring[v]];
+    }
+    num_conflicts /= 2; //every conflicting edge was counted twice
+    for (int v = 0; v < n; ++v) {
+        update_conflicting(v, k, coloring);
+    }
+
+    int best_num_conflicts = num_conflicts;
+    std::uniform_int_distribution<int> random_tenure(0, 9);
+    long long iteration = 0;
+    std::vector<std::pair<int, int>> best_moves;
+    while (num_conflicts > 0) {
+        //checking clock and other threads only every few iterations
+        if ((iteration & 255) == 0 and
+            (best_num_colors <= num_colors or std::chrono::steady_clock::now() > deadline)) {
+            num_iterations += iteration;
+            return false;
+        }
+        iteration++;
+
+        //find best move among all conflicting vertices, tabu moves are only allowed if they give a new best
+        int best_delta = std::numeric_limits<int>::max();
+        best_moves.clear();
+        for (int v : conflicting) {
+            int current = adjacent_colors[v * k + coloring[v]];
+            for (int c = 0; c < k; ++c) {
+                if (c == coloring[v]) continue;
+                int delta = adjacent_colors[v * k + c] - current;
+                bool is_tabu = tabu_until[v * k + c] >= iteration;
+                if (is_tabu and num_conflicts + delta >= best_num_conflicts) continue;
+                if (delta < best_delta) {
+                    best_delta = delta;
+                    best_moves.clear();
+                }
+                if (delta == best_delta) {
+                    best_moves.emplace_back(v, c);
+                }
+            }
+        }
+        if (best_moves.empty()) {
+            //every move is tabu, wait for tenures to run out
+            continue;
+        }
+        auto [v, new_color] = best_moves[std::uniform_int_distribution<std::size_t>(0, best_moves.size() - 1)(rng)];
+
+        //apply move and make old color tabu for v
+        int old_color = coloring[v];
+        coloring[v] = new_color;
+        num_conflicts += best_delta;
+        tabu_until[v * k + old_color] = iteration + random_tenure(rng) + static_cast<long long>(0.6 * num_conflicts);
+        for (Graph::VertexType w : neighbors[v]) {
+            adjacent_colors[w * k + old_color]--;
+            adjacent_colors[w * k + new_color]++;
+            update_conflicting(w, k, coloring);
+        }
+        update_conflicting(v, k, coloring);
+        best_num_conflicts = std::min(best_num_conflicts, num_conflicts);
+    }
+    num_iterations += iteration;
+    return true;
+}
+
+void TabuCol::drop_color(const Graph::NeighborList &neighbors, std::vector<int> &coloring, const int num_colors) {
+    //vertices of color num_colors-1 are moved to the color with fewest neighbors among 0,...,num_colors-2
+    assert(num_colors >= 2);
+    std::vector<int> count(num_colors - 1);
+    for (int v = 0; v < static_cast<int>(coloring.size()); ++v) {
+        if (coloring[v] != num_colors - 1) continue;
+        std::fill(count.begin(), count.end(), 0);
+        for (Graph::VertexType w : neighbors[v]) {
+            if (coloring[w] < num_colors - 1) count[coloring[w]]++;
+        }
+        coloring[v] = static_cast<int>(std::min_element(count.begin(), count.end()) - count.begin());
+    }
+}
+
+int TabuCol::compact_colors(std::vector<int> &coloring) {
+    std::map<int, int> new_color;
+    for (int c : coloring) {
+        new_color.emplace(c, 0);
+    }
+    int next = 0;
+    for (auto &[c, mapped] : new_color) {
+        mapped = next++;
+    }
+    for (int &c : coloring) {
+        c = new_color[c];
+    }
+    return next;
+}
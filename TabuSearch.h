@@ -0,0 +1,53 @@
+#ifndef INCSATGC_TABUSEARCH_H
+#define INCSATGC_TABUSEARCH_H
+
+#include <vector>
+#include <random>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <map>
+
+#include "Graph.h"
+
+//TabuCol local search (Hertz and de Werra, with the dynamic tabu tenure of Galinier and Hao)
+//for a fixed number of colors k, vertices in conflict are recolored to minimize the number of monochromatic edges
+//while recently left colors are tabu, once a legal coloring is found k is decreased by dropping one color class
+class TabuCol {
+public:
+    TabuCol(const Graph::NeighborList &neighbors, unsigned int seed);
+
+    //tries to find a legal coloring with num_colors colors starting from the given (possibly illegal) coloring,
+    //colors have to be in 0,...,num_colors-1, returns true and sets coloring if successful
+    //gives up at the deadline or once best_num_colors (shared between threads) is at most num_colors
+    bool find_coloring(std::vector<int> &coloring, int num_colors,
+                       const std::chrono::steady_clock::time_point &deadline, const std::atomic<int> &best_num_colors);
+
+    //moves the vertices of the largest color onto the remaining colors with the fewest conflicts
+    static void drop_color(const Graph::NeighborList &neighbors, std::vector<int> &coloring, int num_colors);
+    //renumbers the used colors to 0,...,number of used colors - 1 and returns that number
+    static int compact_colors(std::vector<int> &coloring);
+
+    [[nodiscard]] long long get_num_iterations() const { return num_iterations; }
+
+private:
+    const Graph::NeighborList &neighbors;
+    int n;
+    std::mt19937 rng;
+    long long num_iterations = 0;
+
+    //number of neighbors of vertex v with color c is stored at adjacent_colors[v * k + c]
+    std::vector<int> adjacent_colors;
+    //iteration until which vertex v may not get color c again, stored at tabu_until[v * k + c]
+    std::vector<long long> tabu_until;
+    //vertices that have a neighbor of the same color, with their position in that list
+    std::vector<int> conflicting;
+    std::vector<int> conflict_position;
+
+    void update_conflicting(int v, int k, const std::vector<int> &coloring);
+};
+
+
+#endif //INCSATGC_TABUSEARCH_H
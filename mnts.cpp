@@ -1,7 +1,7 @@
 #include "mnts.h"
 
-void MNTS::initializeFromAdjMatrix(const std::vector<Bitset>& adjMatrixInput) {
-    Max_Vtx = adjMatrixInput.size(); // Number of vertices
+void MNTS::allocate(int num_vertices) {
+    Max_Vtx = num_vertices;
     Iter = 0, Wbest = 0, Wf = 0, len0 = 0, len1 = 0, len_best = 0, len = 0, Titer = 0;
 
     // Resize and initialize the graph-related data structures
@@ -14,11 +14,23 @@ void MNTS::initializeFromAdjMatrix(const std::vector<Bitset>& adjMatrixInput) {
     TC1.resize(Max_Vtx);
     BC.resize(Max_Vtx);
     FC1.resize(Max_Vtx);
-    cruset.resize(2000);
+    cruset.resize(std::max(Max_Vtx, 2000));
     Tbest = Bitset(Max_Vtx);
+    TTbest = Bitset(Max_Vtx);
+    initial_clique = Bitset(Max_Vtx);
+    tmp_row = Bitset(Max_Vtx);
 
     We = std::vector<int>(Max_Vtx, 1); //only unweighted
+    Edge = std::vector<Bitset>(Max_Vtx, Bitset(Max_Vtx));
+    adjacMatrix.assign(Max_Vtx, {});
+    active_vertices.clear();
+}
+
+void MNTS::initializeFromAdjMatrix(const std::vector<Bitset>& adjMatrixInput) {
+    allocate(static_cast<int>(adjMatrixInput.size()));
     Edge = adjMatrixInput; // copy adjacency from input
+    active_vertices.resize(Max_Vtx);
+    std::iota(active_vertices.begin(), active_vertices.end(), 0);
 
     // invert edges to obtain complement graph
     for (int x = 0; x < Max_Vtx; x++) {
@@ -40,6 +52,47 @@ void MNTS::initializeFromAdjMatrix(const std::vector<Bitset>& adjMatrixInput) {
     }
 }
 
+void MNTS::updateGraph(const std::vector<Bitset>& adjMatrixInput, const Bitset& active) {
+    assert(static_cast<int>(adjMatrixInput.size()) == Max_Vtx and static_cast<int>(active.size()) == Max_Vtx);
+    active_vertices.clear();
+    for (int x = 0; x < Max_Vtx; x++) {
+        //complement row restricted to the active vertices, inactive vertices get no edges at all
+        if (active.test(x)) {
+            active_vertices.push_back(x);
+            tmp_row = active;
+            tmp_row -= adjMatrixInput[x];
+            tmp_row.reset(x);
+        }
+        else {
+            tmp_row.reset();
+        }
+        if (tmp_row == Edge[x]) {
+            continue;
+        }
+        Edge[x] = tmp_row;
+        adjacMatrix[x].clear();
+        for (auto y = Edge[x].find_first(); y != Bitset::npos; y = Edge[x].find_next(y)) {
+            adjacMatrix[x].push_back(static_cast<int>(y));
+        }
+    }
+}
+
+void MNTS::setInitialClique(const Bitset& clique) {
+    assert(static_cast<int>(clique.size()) == Max_Vtx);
+    initial_clique = clique;
+}
+
+void MNTS::seedInitialClique() {
+    //expand the current set by the vertices of the initial clique that are still free, i.e. in C0
+    for (auto v = initial_clique.find_first(); v != Bitset::npos; v = initial_clique.find_next(v)) {
+        if (funch[v] == 0 and not vectex.test(v) and address[v] < len0 and C0[address[v]] == static_cast<int>(v)) {
+            expand(address[v]);
+            Iter++;
+        }
+    }
+    initial_clique.reset();
+}
+
 
 void MNTS::clearGamma() {
     vectex.reset();
@@ -47,11 +100,11 @@ void MNTS::clearGamma() {
     std::fill(address.begin(), address.end(), 0);
     std::fill(tabuin.begin(), tabuin.end(), 0);
 
-    for (int i = 0; i < Max_Vtx; i++) {
-        C0[i] = i;
-        address[i] = i;
+    for (int i = 0; i < static_cast<int>(active_vertices.size()); i++) {
+        C0[i] = active_vertices[i];
+        address[active_vertices[i]] = i;
     }
-    len0 = Max_Vtx;
+    len0 = static_cast<int>(active_vertices.size());
     len1 = 0;
     len = 0;
     Wf = 0;
@@ -410,6 +463,9 @@ int MNTS::tabu(int Max_Iter) {
     int am, am1, ww, ww1, ww2, ti, m1;
     Iter = 0;
     clearGamma();
+    seedInitialClique();
+    if (Wbest >= Waim)
+        return Wbest;
 
     // First while loop: keep expanding as long as C0 is not exhausted
     while (true){
@@ -544,7 +600,13 @@ int MNTS::maxTabu() {
 }
 
 
+Bitset MNTS::runSearch(int aim) {
+    Waim = aim;
+    return runSearch();
+}
+
 Bitset MNTS::runSearch() {
+    TTbest.reset();
     Wbest = maxTabu();
     // outputResults();
     return TTbest;
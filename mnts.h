@@ -29,6 +29,8 @@
 
 #include <vector>
 #include <algorithm>
+#include <numeric>
+#include <cassert>
 #include <random>
 #include <cstring>
 #include <iostream>
@@ -60,6 +62,11 @@ class MNTS {
     std::vector<Bitset> Edge;
     Bitset Tbest, TTbest;
     std::vector<Bitset> best_list; //possibly track multiple cliques that achieve the aim, currently not done
+    //vertices taking part in the search, the others have no edges in the complement graph and are never selected
+    std::vector<int> active_vertices;
+    //clique the first tabu run of the next search starts from
+    Bitset initial_clique;
+    Bitset tmp_row; //buffer for updating the complement graph
 
     std::mt19937 rng;
     std::uniform_int_distribution<int> dist;
@@ -69,6 +76,8 @@ class MNTS {
     }
 
     void initializeFromAdjMatrix(const std::vector<Bitset>& adjMatrixInput);
+    void allocate(int num_vertices);
+    void seedInitialClique();
     void clearGamma();
     int selectC0();
     int WselectC0();
@@ -95,7 +104,21 @@ public:
         dist = std::uniform_int_distribution<int>();
         len_time = static_cast<int>(mnts_length / len_improve) + 1;
     }
+    //engine that is kept alive over many searches on changing graphs with at most num_vertices vertices,
+    //the graph is given before each search by updateGraph
+    MNTS(int num_vertices, const int mnts_length, const int lenImprove, int random_seed = 12345)
+        : Waim(0), len_improve(lenImprove) {
+        allocate(num_vertices);
+        rng.seed(random_seed);
+        dist = std::uniform_int_distribution<int>();
+        len_time = static_cast<int>(mnts_length / len_improve) + 1;
+    }
+    //only rebuilds the complement adjacency of vertices whose neighborhood in the active vertices changed
+    void updateGraph(const std::vector<Bitset>& adjMatrixInput, const Bitset& active);
+    //clique (in the graph, i.e. independent set of the complement) used as starting point of the next search
+    void setInitialClique(const Bitset& clique);
     Bitset runSearch();
+    Bitset runSearch(int aim);
 };
 
 #endif //MNTS_CPP_H